@@ -0,0 +1,308 @@
+#include "SSuzieDiagnostics.h"
+#include "SuziePlugin.h"
+#include "SuzieConstructionStats.h"
+#include "SuzieGenerationProfile.h"
+#include "SuzieMemoryReport.h"
+#include "Dom/JsonObject.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SSegmentedControl.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "FSuziePluginModule"
+
+static FSuzieDiagnosticsCell MakeTextCell(const FString& Text)
+{
+    return {Text, 0.0};
+}
+
+static FSuzieDiagnosticsCell MakeNumberCell(const double Value, const int32 NumFractionalDigits)
+{
+    FNumberFormattingOptions FormattingOptions;
+    FormattingOptions.MinimumFractionalDigits = NumFractionalDigits;
+    FormattingOptions.MaximumFractionalDigits = NumFractionalDigits;
+    return {FText::AsNumber(Value, &FormattingOptions).ToString(), Value};
+}
+
+// Row of the list view. Looks up the cell of each column by the index of the column in the current section
+class SSuzieDiagnosticsRow : public SMultiColumnTableRow<TSharedPtr<FSuzieDiagnosticsRow>>
+{
+public:
+    SLATE_BEGIN_ARGS(SSuzieDiagnosticsRow) {}
+        SLATE_ARGUMENT(TSharedPtr<FSuzieDiagnosticsRow>, Row)
+        SLATE_ARGUMENT(TArray<FName>, ColumnIds)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+    {
+        Row = InArgs._Row;
+        ColumnIds = InArgs._ColumnIds;
+        SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        const int32 CellIndex = ColumnIds.IndexOfByKey(ColumnName);
+        return SNew(STextBlock).Text(Row->Cells.IsValidIndex(CellIndex) ? FText::AsCultureInvariant(Row->Cells[CellIndex].Text) : FText::GetEmpty());
+    }
+private:
+    TSharedPtr<FSuzieDiagnosticsRow> Row;
+    TArray<FName> ColumnIds;
+};
+
+void SSuzieDiagnostics::Construct(const FArguments& InArgs)
+{
+    HeaderRow = SNew(SHeaderRow);
+    ListView = SNew(SListView<TSharedPtr<FSuzieDiagnosticsRow>>)
+        .ListItemsSource(&VisibleRows)
+        .OnGenerateRow(this, &SSuzieDiagnostics::OnGenerateRow)
+        .HeaderRow(HeaderRow);
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SSegmentedControl<ESuzieDiagnosticsSection>)
+                .Value_Lambda([this]() { return CurrentSection; })
+                .OnValueChanged(this, &SSuzieDiagnostics::SelectSection)
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Files).Text(LOCTEXT("DiagnosticsFiles", "Files"))
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Phases).Text(LOCTEXT("DiagnosticsPhases", "Phases"))
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Types).Text(LOCTEXT("DiagnosticsTypes", "Slowest Types"))
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Packages).Text(LOCTEXT("DiagnosticsPackages", "Package Memory"))
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Construction).Text(LOCTEXT("DiagnosticsConstruction", "Construction"))
+                + SSegmentedControl<ESuzieDiagnosticsSection>::Slot(ESuzieDiagnosticsSection::Fallbacks).Text(LOCTEXT("DiagnosticsFallbacks", "Fallbacks"))
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            .Padding(8.0f, 0.0f)
+            [
+                SNew(SSearchBox)
+                .OnTextChanged_Lambda([this](const FText& FilterText)
+                {
+                    FilterString = FilterText.ToString();
+                    UpdateVisibleRows();
+                })
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("DiagnosticsRefresh", "Refresh"))
+                .ToolTipText(LOCTEXT("DiagnosticsRefreshTooltip", "Reads the generation profile again and measures the current memory and construction counters"))
+                .OnClicked_Lambda([this]()
+                {
+                    Refresh();
+                    return FReply::Handled();
+                })
+            ]
+        ]
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(STextBlock)
+            .Text_Lambda([this]() { return SummaryText; })
+            .AutoWrapText(true)
+        ]
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            SNew(SBorder)
+            .Padding(0.0f)
+            [
+                ListView.ToSharedRef()
+            ]
+        ]
+    ];
+
+    Refresh();
+}
+
+void SSuzieDiagnostics::Refresh()
+{
+    Sections.Reset();
+    Sections.SetNum(static_cast<int32>(ESuzieDiagnosticsSection::Fallbacks) + 1);
+    auto AddRow = [](FSection& Section, TArray<FSuzieDiagnosticsCell>&& Cells)
+    {
+        Section.Rows.Add(MakeShared<FSuzieDiagnosticsRow>(FSuzieDiagnosticsRow{MoveTemp(Cells)}));
+    };
+
+    // Timings come from the profile written by the last generation run, which is only written when profiling is enabled
+    FSection& Files = GetSection(ESuzieDiagnosticsSection::Files);
+    Files.Columns = {{TEXT("File"), LOCTEXT("ColumnFile", "File"), false, 3.0f}, {TEXT("Seconds"), LOCTEXT("ColumnSeconds", "Seconds"), true},
+        {TEXT("SizeMB"), LOCTEXT("ColumnSizeMB", "Size MB"), true}};
+    FSection& Phases = GetSection(ESuzieDiagnosticsSection::Phases);
+    Phases.Columns = {{TEXT("Phase"), LOCTEXT("ColumnPhase", "Phase"), false, 3.0f}, {TEXT("Seconds"), LOCTEXT("ColumnSeconds", "Seconds"), true},
+        {TEXT("UsedMB"), LOCTEXT("ColumnUsedMB", "Used Memory MB"), true}};
+    FSection& Types = GetSection(ESuzieDiagnosticsSection::Types);
+    Types.Columns = {{TEXT("Type"), LOCTEXT("ColumnType", "Type"), false, 4.0f}, {TEXT("Milliseconds"), LOCTEXT("ColumnMilliseconds", "Milliseconds"), true}};
+
+    const TSharedPtr<FJsonObject> Profile = FSuzieGenerationProfile::Load(FSuziePluginModule::GetGenerationProfileFilePath());
+    if (Profile.IsValid())
+    {
+        const TArray<TSharedPtr<FJsonValue>>* ProfileEntries;
+        if (Profile->TryGetArrayField(TEXT("files"), ProfileEntries))
+        {
+            for (const TSharedPtr<FJsonValue>& FileValue : *ProfileEntries)
+            {
+                const TSharedPtr<FJsonObject> File = FileValue->AsObject();
+                AddRow(Files, {MakeTextCell(File->GetStringField(TEXT("name"))), MakeNumberCell(File->GetNumberField(TEXT("seconds")), 3),
+                    MakeNumberCell(File->GetNumberField(TEXT("size_bytes")) / (1024.0 * 1024.0), 1)});
+            }
+        }
+        if (Profile->TryGetArrayField(TEXT("phases"), ProfileEntries))
+        {
+            for (const TSharedPtr<FJsonValue>& PhaseValue : *ProfileEntries)
+            {
+                const TSharedPtr<FJsonObject> Phase = PhaseValue->AsObject();
+                AddRow(Phases, {MakeTextCell(Phase->GetStringField(TEXT("name"))), MakeNumberCell(Phase->GetNumberField(TEXT("seconds")), 3),
+                    MakeNumberCell(Phase->GetNumberField(TEXT("used_physical_bytes")) / (1024.0 * 1024.0), 1)});
+            }
+        }
+        if (Profile->TryGetArrayField(TEXT("most_expensive_types"), ProfileEntries))
+        {
+            for (const TSharedPtr<FJsonValue>& TypeValue : *ProfileEntries)
+            {
+                const TSharedPtr<FJsonObject> Type = TypeValue->AsObject();
+                AddRow(Types, {MakeTextCell(Type->GetStringField(TEXT("path"))), MakeNumberCell(Type->GetNumberField(TEXT("seconds")) * 1000.0, 2)});
+            }
+        }
+        SummaryText = FText::Format(LOCTEXT("DiagnosticsSummary", "Last generation at {0} took {1} seconds, peak memory {2} MB. {3} properties fell back to a placeholder type"),
+            FText::AsCultureInvariant(Profile->GetStringField(TEXT("timestamp"))), FText::AsNumber(Profile->GetNumberField(TEXT("total_seconds"))),
+            FText::AsNumber(FMath::RoundToInt64(Profile->GetNumberField(TEXT("peak_used_physical_bytes")) / (1024.0 * 1024.0))),
+            FText::AsNumber(FModuleManager::GetModuleChecked<FSuziePluginModule>(TEXT("Suzie")).GetGenerationFallbacks().Num()));
+    }
+    else
+    {
+        SummaryText = LOCTEXT("DiagnosticsNoProfile", "No generation profile has been written. Enable Write Generation Profile in Project Settings > Plugins > Suzie and restart the editor to see timings");
+    }
+
+    FSection& Packages = GetSection(ESuzieDiagnosticsSection::Packages);
+    Packages.Columns = {{TEXT("Package"), LOCTEXT("ColumnPackage", "Package"), false, 3.0f}, {TEXT("TotalKB"), LOCTEXT("ColumnTotalKB", "Total KB"), true},
+        {TEXT("TypesKB"), LOCTEXT("ColumnTypesKB", "Types KB"), true}, {TEXT("PropertiesKB"), LOCTEXT("ColumnPropertiesKB", "Properties KB"), true},
+        {TEXT("FunctionsKB"), LOCTEXT("ColumnFunctionsKB", "Functions KB"), true}, {TEXT("DefaultObjectsKB"), LOCTEXT("ColumnDefaultObjectsKB", "Default Objects KB"), true},
+        {TEXT("ArchetypesKB"), LOCTEXT("ColumnArchetypesKB", "Archetypes KB"), true}, {TEXT("MetaDataKB"), LOCTEXT("ColumnMetaDataKB", "Metadata KB"), true}};
+    TArray<FSuzieTypeMemory> TypeMemory;
+    TArray<FSuzieTypeMemory> PackageMemory;
+    FSuziePluginModule::GatherGeneratedTypeMemory(TypeMemory, PackageMemory);
+    for (const FSuzieTypeMemory& Memory : PackageMemory)
+    {
+        AddRow(Packages, {MakeTextCell(Memory.PackageName), MakeNumberCell(Memory.GetTotalBytes() / 1024.0, 1), MakeNumberCell(Memory.TypeBytes / 1024.0, 1),
+            MakeNumberCell(Memory.PropertyBytes / 1024.0, 1), MakeNumberCell(Memory.FunctionBytes / 1024.0, 1), MakeNumberCell(Memory.DefaultObjectBytes / 1024.0, 1),
+            MakeNumberCell(Memory.ArchetypeBytes / 1024.0, 1), MakeNumberCell(Memory.MetaDataBytes / 1024.0, 1)});
+    }
+
+    // Counters are only collected while Suzie.ConstructionStats is enabled
+    FSection& Construction = GetSection(ESuzieDiagnosticsSection::Construction);
+    Construction.Columns = {{TEXT("Class"), LOCTEXT("ColumnClass", "Class"), false, 3.0f}, {TEXT("Constructed"), LOCTEXT("ColumnConstructed", "Constructed"), true},
+        {TEXT("ConstructMs"), LOCTEXT("ColumnConstructMs", "Construct ms"), true}, {TEXT("AverageUs"), LOCTEXT("ColumnAverageUs", "Average us"), true},
+        {TEXT("Subobjects"), LOCTEXT("ColumnSubobjects", "Subobjects"), true}, {TEXT("Destroyed"), LOCTEXT("ColumnDestroyed", "Destroyed"), true},
+        {TEXT("DestroyMs"), LOCTEXT("ColumnDestroyMs", "Destroy ms"), true}};
+    for (const TSharedRef<FSuzieClassConstructionStats>& Stats : FSuzieConstructionStats::GetAllClassStats())
+    {
+        const int64 NumConstructed = Stats->NumConstructed.load(std::memory_order_relaxed);
+        const int64 NumDestroyed = Stats->NumDestroyed.load(std::memory_order_relaxed);
+        if (NumConstructed == 0 && NumDestroyed == 0)
+        {
+            continue;
+        }
+        const double ConstructionMs = FPlatformTime::ToMilliseconds64(Stats->ConstructionCycles.load(std::memory_order_relaxed));
+        AddRow(Construction, {MakeTextCell(Stats->ClassPath), MakeNumberCell(static_cast<double>(NumConstructed), 0), MakeNumberCell(ConstructionMs, 2),
+            MakeNumberCell(NumConstructed > 0 ? ConstructionMs * 1000.0 / NumConstructed : 0.0, 2), MakeNumberCell(static_cast<double>(Stats->NumSubobjectsCreated.load(std::memory_order_relaxed)), 0),
+            MakeNumberCell(static_cast<double>(NumDestroyed), 0), MakeNumberCell(FPlatformTime::ToMilliseconds64(Stats->DestructionCycles.load(std::memory_order_relaxed)), 2)});
+    }
+
+    FSection& Fallbacks = GetSection(ESuzieDiagnosticsSection::Fallbacks);
+    Fallbacks.Columns = {{TEXT("Owner"), LOCTEXT("ColumnOwner", "Owner"), false, 3.0f}, {TEXT("Property"), LOCTEXT("ColumnProperty", "Property"), false},
+        {TEXT("MissingType"), LOCTEXT("ColumnMissingType", "Missing Type"), false, 3.0f}, {TEXT("UsedInstead"), LOCTEXT("ColumnUsedInstead", "Used Instead"), false}};
+    for (const FSuzieGenerationFallback& Fallback : FModuleManager::GetModuleChecked<FSuziePluginModule>(TEXT("Suzie")).GetGenerationFallbacks())
+    {
+        AddRow(Fallbacks, {MakeTextCell(Fallback.OwnerPath), MakeTextCell(Fallback.PropertyName), MakeTextCell(Fallback.MissingTypePath),
+            MakeTextCell(Fallback.FallbackTypeName.IsEmpty() ? TEXT("(left out)") : Fallback.FallbackTypeName)});
+    }
+
+    SelectSection(CurrentSection);
+}
+
+void SSuzieDiagnostics::SelectSection(const ESuzieDiagnosticsSection Section)
+{
+    CurrentSection = Section;
+    SortColumnId = NAME_None;
+    SortMode = EColumnSortMode::None;
+
+    HeaderRow->ClearColumns();
+    for (const FColumn& Column : GetSection(CurrentSection).Columns)
+    {
+        HeaderRow->AddColumn(SHeaderRow::Column(Column.Id)
+            .DefaultLabel(Column.Label)
+            .FillWidth(Column.FillWidth)
+            .HAlignCell(Column.bIsNumeric ? HAlign_Right : HAlign_Left)
+            .SortMode(this, &SSuzieDiagnostics::GetColumnSortMode, Column.Id)
+            .OnSort(this, &SSuzieDiagnostics::OnSortModeChanged));
+    }
+    UpdateVisibleRows();
+    // Rows generated for the columns of the previous section cannot be reused
+    ListView->RebuildList();
+}
+
+void SSuzieDiagnostics::UpdateVisibleRows()
+{
+    const FSection& Section = GetSection(CurrentSection);
+    VisibleRows.Reset();
+    for (const TSharedPtr<FSuzieDiagnosticsRow>& Row : Section.Rows)
+    {
+        if (FilterString.IsEmpty() || Row->Cells.ContainsByPredicate([&](const FSuzieDiagnosticsCell& Cell) { return Cell.Text.Contains(FilterString); }))
+        {
+            VisibleRows.Add(Row);
+        }
+    }
+
+    const int32 SortColumnIndex = Section.Columns.IndexOfByPredicate([&](const FColumn& Column) { return Column.Id == SortColumnId; });
+    if (SortColumnIndex != INDEX_NONE && SortMode != EColumnSortMode::None)
+    {
+        const bool bIsNumeric = Section.Columns[SortColumnIndex].bIsNumeric;
+        const bool bAscending = SortMode == EColumnSortMode::Ascending;
+        VisibleRows.StableSort([&](const TSharedPtr<FSuzieDiagnosticsRow>& A, const TSharedPtr<FSuzieDiagnosticsRow>& B)
+        {
+            const FSuzieDiagnosticsCell& CellA = A->Cells[SortColumnIndex];
+            const FSuzieDiagnosticsCell& CellB = B->Cells[SortColumnIndex];
+            const bool bIsLess = bIsNumeric ? CellA.Value < CellB.Value : CellA.Text < CellB.Text;
+            const bool bIsGreater = bIsNumeric ? CellA.Value > CellB.Value : CellB.Text < CellA.Text;
+            return bAscending ? bIsLess : bIsGreater;
+        });
+    }
+    ListView->RequestListRefresh();
+}
+
+TSharedRef<ITableRow> SSuzieDiagnostics::OnGenerateRow(TSharedPtr<FSuzieDiagnosticsRow> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    TArray<FName> ColumnIds;
+    for (const FColumn& Column : GetSection(CurrentSection).Columns)
+    {
+        ColumnIds.Add(Column.Id);
+    }
+    return SNew(SSuzieDiagnosticsRow, OwnerTable).Row(Row).ColumnIds(ColumnIds);
+}
+
+void SSuzieDiagnostics::OnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode)
+{
+    SortColumnId = ColumnId;
+    SortMode = NewSortMode;
+    UpdateVisibleRows();
+}
+
+EColumnSortMode::Type SSuzieDiagnostics::GetColumnSortMode(const FName ColumnId) const
+{
+    return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+
+// Cell of a diagnostics table. Numeric cells are sorted by their value, all other cells by their text
+struct FSuzieDiagnosticsCell
+{
+    FString Text;
+    double Value{};
+};
+
+struct FSuzieDiagnosticsRow
+{
+    TArray<FSuzieDiagnosticsCell> Cells;
+};
+
+enum class ESuzieDiagnosticsSection : uint8
+{
+    Files,
+    Phases,
+    Types,
+    Packages,
+    Construction,
+    Fallbacks,
+};
+
+// Shows the last generation run: timings of files, phases and types from the generation profile, memory of the generated packages,
+// runtime construction counters of the dynamic classes and the properties that fell back to a placeholder type
+class SSuzieDiagnostics : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SSuzieDiagnostics) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+private:
+    struct FColumn
+    {
+        FName Id;
+        FText Label;
+        bool bIsNumeric{};
+        float FillWidth{1.0f};
+    };
+    struct FSection
+    {
+        TArray<FColumn> Columns;
+        TArray<TSharedPtr<FSuzieDiagnosticsRow>> Rows;
+    };
+
+    /** Gathers the data of all sections again. Measuring the memory of the generated types can take a moment on big dumps */
+    void Refresh();
+    void SelectSection(ESuzieDiagnosticsSection Section);
+    /** Applies the filter and the sort order to the rows of the current section */
+    void UpdateVisibleRows();
+
+    TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FSuzieDiagnosticsRow> Row, const TSharedRef<STableViewBase>& OwnerTable);
+    void OnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+    EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+
+    FSection& GetSection(const ESuzieDiagnosticsSection Section) { return Sections[static_cast<int32>(Section)]; }
+
+    // Indexed by section
+    TArray<FSection> Sections;
+    ESuzieDiagnosticsSection CurrentSection{ESuzieDiagnosticsSection::Phases};
+    TArray<TSharedPtr<FSuzieDiagnosticsRow>> VisibleRows;
+    TSharedPtr<SHeaderRow> HeaderRow;
+    TSharedPtr<SListView<TSharedPtr<FSuzieDiagnosticsRow>>> ListView;
+    FString FilterString;
+    FName SortColumnId;
+    EColumnSortMode::Type SortMode{EColumnSortMode::None};
+    FText SummaryText;
+};
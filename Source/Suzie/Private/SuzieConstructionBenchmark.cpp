@@ -0,0 +1,160 @@
+#include "SuziePlugin.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+
+// Classes measured together, and the time per object spent on each part of their lifetime
+struct FSuzieConstructionBenchmarkCase
+{
+    const TCHAR* Name;
+    TArray<UClass*> Classes;
+    int32 NumObjects{};
+    int32 NumSubobjects{};
+    double ConstructionSeconds{};
+    double PropertyInitializationSeconds{};
+    double DestructionSeconds{};
+};
+
+static double GetNanosecondsPerObject(const double Seconds, const int32 NumObjects)
+{
+    return NumObjects > 0 ? Seconds * 1e9 / NumObjects : 0.0;
+}
+
+// Full purge, so that the objects marked as garbage are destroyed before it returns
+static double CollectGarbageAndMeasure()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+    return FPlatformTime::Seconds() - StartTime;
+}
+
+void FSuziePluginModule::BenchmarkObjectConstruction(const int32 NumObjectsPerClass, const int32 NumClassesPerCase)
+{
+    // Actors can only be spawned into a world, so they are left out. Their components and all other objects are created with NewObject like in the game
+    auto CanBenchmarkClass = [](const UClass* Class)
+    {
+        return !Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists | CLASS_Interface) && !Class->IsChildOf<AActor>() &&
+            GetTransientPackage()->IsA(Class->ClassWithin);
+    };
+    auto GetDynamicHierarchyDepth = [](const UClass* Class)
+    {
+        int32 Depth = 0;
+        for (; Class && Class->ClassConstructor == &PolymorphicClassConstructorInvocationHelper; Class = Class->GetSuperClass())
+        {
+            Depth++;
+        }
+        return Depth;
+    };
+
+    // Native parents of the single level classes are measured as the baseline, so the cases differ only in the polymorphic constructor
+    FSuzieConstructionBenchmarkCase NativeCase{TEXT("Native parent")};
+    FSuzieConstructionBenchmarkCase SingleLevelCase{TEXT("Single level dynamic")};
+    FSuzieConstructionBenchmarkCase DeepCase{TEXT("Deep dynamic hierarchy")};
+    TArray<UClass*> DynamicClasses;
+    DynamicClassConstructionData.GenerateKeyArray(DynamicClasses);
+    DynamicClasses.Sort([](const UClass& A, const UClass& B) { return A.GetPathName() < B.GetPathName(); });
+    for (UClass* Class : DynamicClasses)
+    {
+        if (!CanBenchmarkClass(Class))
+        {
+            continue;
+        }
+        const int32 Depth = GetDynamicHierarchyDepth(Class);
+        if (Depth == 1 && SingleLevelCase.Classes.Num() < NumClassesPerCase)
+        {
+            SingleLevelCase.Classes.Add(Class);
+            if (CanBenchmarkClass(Class->GetSuperClass()))
+            {
+                NativeCase.Classes.AddUnique(Class->GetSuperClass());
+            }
+        }
+        // Deep hierarchies are the ones that apply the subobject overrides and suppressions of every class in the hierarchy
+        else if (Depth >= 3 && DeepCase.Classes.Num() < NumClassesPerCase)
+        {
+            DeepCase.Classes.Add(Class);
+        }
+    }
+
+    const double EmptyGarbageCollectionSeconds = CollectGarbageAndMeasure();
+    for (FSuzieConstructionBenchmarkCase* Case : {&NativeCase, &SingleLevelCase, &DeepCase})
+    {
+        for (UClass* Class : Case->Classes)
+        {
+            TArray<UObject*> Objects;
+            Objects.Reserve(NumObjectsPerClass);
+            const double ConstructionStartTime = FPlatformTime::Seconds();
+            for (int32 ObjectIndex = 0; ObjectIndex < NumObjectsPerClass; ObjectIndex++)
+            {
+                Objects.Add(NewObject<UObject>(GetTransientPackage(), Class, NAME_None, RF_Transient));
+            }
+            Case->ConstructionSeconds += FPlatformTime::Seconds() - ConstructionStartTime;
+            Case->NumObjects += Objects.Num();
+
+            ForEachObjectWithOuter(Objects[0], [&](UObject*) { Case->NumSubobjects += Objects.Num(); }, true);
+            for (UObject* Object : Objects)
+            {
+                Object->MarkAsGarbage();
+            }
+            // Garbage collection has a fixed cost, which is not a part of destroying the objects
+            Case->DestructionSeconds += FMath::Max(0.0, CollectGarbageAndMeasure() - EmptyGarbageCollectionSeconds);
+
+            // Initialization of the properties that need a constructor call is measured on its own, in memory that is not an object
+            TArray<const FProperty*> PropertiesToConstruct;
+            for (const UClass* DynamicClass = Class; DynamicClass && DynamicClass->ClassConstructor == &PolymorphicClassConstructorInvocationHelper; DynamicClass = DynamicClass->GetSuperClass())
+            {
+                if (const FDynamicClassConstructionData* ClassConstructionData = DynamicClassConstructionData.Find(DynamicClass))
+                {
+                    PropertiesToConstruct.Append(ClassConstructionData->PropertiesToConstruct);
+                }
+            }
+            if (!PropertiesToConstruct.IsEmpty())
+            {
+                const int32 ObjectSize = Align(Class->GetStructureSize(), Class->GetMinAlignment());
+                uint8* ObjectMemory = static_cast<uint8*>(FMemory::MallocZeroed(static_cast<SIZE_T>(ObjectSize) * NumObjectsPerClass, Class->GetMinAlignment()));
+                const double InitializationStartTime = FPlatformTime::Seconds();
+                for (int32 ObjectIndex = 0; ObjectIndex < NumObjectsPerClass; ObjectIndex++)
+                {
+                    for (const FProperty* Property : PropertiesToConstruct)
+                    {
+                        Property->InitializeValue_InContainer(ObjectMemory + static_cast<SIZE_T>(ObjectIndex) * ObjectSize);
+                    }
+                }
+                Case->PropertyInitializationSeconds += FPlatformTime::Seconds() - InitializationStartTime;
+                for (int32 ObjectIndex = 0; ObjectIndex < NumObjectsPerClass; ObjectIndex++)
+                {
+                    for (const FProperty* Property : PropertiesToConstruct)
+                    {
+                        Property->DestroyValue_InContainer(ObjectMemory + static_cast<SIZE_T>(ObjectIndex) * ObjectSize);
+                    }
+                }
+                FMemory::Free(ObjectMemory);
+            }
+        }
+    }
+
+    UE_LOG(LogSuzie, Display, TEXT("Construction benchmark, %d objects per class:"), NumObjectsPerClass);
+    UE_LOG(LogSuzie, Display, TEXT("  %-24s %8s %10s %12s %14s %12s %12s"), TEXT("Case"), TEXT("Classes"), TEXT("Objects"), TEXT("Subobjects"),
+        TEXT("Construct ns"), TEXT("Props ns"), TEXT("Destroy ns"));
+    for (const FSuzieConstructionBenchmarkCase* Case : {&NativeCase, &SingleLevelCase, &DeepCase})
+    {
+        if (Case->Classes.IsEmpty())
+        {
+            UE_LOG(LogSuzie, Display, TEXT("  %-24s no suitable classes"), Case->Name);
+            continue;
+        }
+        UE_LOG(LogSuzie, Display, TEXT("  %-24s %8d %10d %12d %14.1f %12.1f %12.1f"), Case->Name, Case->Classes.Num(), Case->NumObjects, Case->NumSubobjects,
+            GetNanosecondsPerObject(Case->ConstructionSeconds, Case->NumObjects), GetNanosecondsPerObject(Case->PropertyInitializationSeconds, Case->NumObjects),
+            GetNanosecondsPerObject(Case->DestructionSeconds, Case->NumObjects));
+    }
+}
+
+static FAutoConsoleCommand BenchmarkConstructionCommand(
+    TEXT("Suzie.BenchmarkConstruction"),
+    TEXT("Creates and garbage collects objects of native parent classes, single level dynamic classes and deep dynamic hierarchies, and logs the time per object ")
+    TEXT("spent on construction, property initialization and destruction. Optional arguments are the number of objects per class (1000) and classes per case (16)"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuziePluginModule::BenchmarkObjectConstruction(Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000, Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 16);
+    }));
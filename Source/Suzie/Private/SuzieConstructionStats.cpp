@@ -0,0 +1,161 @@
+#include "SuzieConstructionStats.h"
+#include "SuziePlugin.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_STAT(STAT_SuzieDynamicObjectConstruction);
+DEFINE_STAT(STAT_SuzieDynamicObjectDestruction);
+DEFINE_STAT(STAT_SuzieDynamicObjectsConstructed);
+DEFINE_STAT(STAT_SuzieDynamicSubobjectsCreated);
+DEFINE_STAT(STAT_SuzieDynamicObjectsDestroyed);
+
+static TAutoConsoleVariable<bool> CVarSuzieConstructionStats(
+    TEXT("Suzie.ConstructionStats"),
+    false,
+    TEXT("Collects per-class construction and destruction statistics of dynamic classes. Use Suzie.DumpConstructionStats to view them"));
+
+// Counters of all classes ever generated, by class path. Only modified on the game thread while types are generated
+static TMap<FString, TSharedRef<FSuzieClassConstructionStats>> ClassConstructionStatsByPath;
+
+bool FSuzieConstructionStats::IsEnabled()
+{
+    return CVarSuzieConstructionStats.GetValueOnAnyThread();
+}
+
+TSharedRef<FSuzieClassConstructionStats> FSuzieConstructionStats::FindOrAddClassStats(const FString& ClassPath)
+{
+    check(IsInGameThread());
+    if (const TSharedRef<FSuzieClassConstructionStats>* ExistingStats = ClassConstructionStatsByPath.Find(ClassPath))
+    {
+        return *ExistingStats;
+    }
+    TSharedRef<FSuzieClassConstructionStats> NewStats = MakeShared<FSuzieClassConstructionStats>();
+    NewStats->ClassPath = ClassPath;
+    ClassConstructionStatsByPath.Add(ClassPath, NewStats);
+    return NewStats;
+}
+
+TArray<TSharedRef<FSuzieClassConstructionStats>> FSuzieConstructionStats::GetAllClassStats()
+{
+    check(IsInGameThread());
+    TArray<TSharedRef<FSuzieClassConstructionStats>> AllClassStats;
+    ClassConstructionStatsByPath.GenerateValueArray(AllClassStats);
+    return AllClassStats;
+}
+
+FSuzieConstructionStats::FScopedConstruction::FScopedConstruction(FSuzieClassConstructionStats* InStats)
+{
+    if (InStats && IsEnabled())
+    {
+        Stats = InStats;
+        StartCycles = FPlatformTime::Cycles64();
+    }
+}
+
+FSuzieConstructionStats::FScopedConstruction::~FScopedConstruction()
+{
+    if (Stats)
+    {
+        Stats->ConstructionCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+        Stats->NumConstructed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FSuzieConstructionStats::FScopedDestruction::FScopedDestruction(FSuzieClassConstructionStats* InStats)
+{
+    if (InStats && IsEnabled())
+    {
+        Stats = InStats;
+        StartCycles = FPlatformTime::Cycles64();
+    }
+}
+
+FSuzieConstructionStats::FScopedDestruction::~FScopedDestruction()
+{
+    if (Stats)
+    {
+        Stats->DestructionCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+        Stats->NumDestroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FSuzieConstructionStats::CountSubobjectCreated(FSuzieClassConstructionStats* Stats)
+{
+    if (Stats && IsEnabled())
+    {
+        Stats->NumSubobjectsCreated.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FSuzieConstructionStats::Dump(const int32 NumLoggedRows)
+{
+    struct FClassRow
+    {
+        const FSuzieClassConstructionStats* Stats;
+        int64 NumConstructed;
+        double ConstructionMs;
+        int64 NumSubobjectsCreated;
+        int64 NumDestroyed;
+        double DestructionMs;
+    };
+    TArray<FClassRow> Rows;
+    FClassRow Total{};
+    for (const auto& [ClassPath, Stats] : ClassConstructionStatsByPath)
+    {
+        const FClassRow Row{&Stats.Get(), Stats->NumConstructed.load(std::memory_order_relaxed),
+            FPlatformTime::ToMilliseconds64(Stats->ConstructionCycles.load(std::memory_order_relaxed)), Stats->NumSubobjectsCreated.load(std::memory_order_relaxed),
+            Stats->NumDestroyed.load(std::memory_order_relaxed), FPlatformTime::ToMilliseconds64(Stats->DestructionCycles.load(std::memory_order_relaxed))};
+        if (Row.NumConstructed > 0 || Row.NumDestroyed > 0)
+        {
+            Rows.Add(Row);
+            Total.NumConstructed += Row.NumConstructed;
+            Total.ConstructionMs += Row.ConstructionMs;
+            Total.NumSubobjectsCreated += Row.NumSubobjectsCreated;
+            Total.NumDestroyed += Row.NumDestroyed;
+            Total.DestructionMs += Row.DestructionMs;
+        }
+    }
+    Rows.Sort([](const FClassRow& A, const FClassRow& B) { return A.ConstructionMs + A.DestructionMs > B.ConstructionMs + B.DestructionMs; });
+
+    if (!IsEnabled())
+    {
+        UE_LOG(LogSuzie, Display, TEXT("Construction stats are not being collected, enable them with Suzie.ConstructionStats 1"));
+    }
+    UE_LOG(LogSuzie, Display, TEXT("%lld objects of %d dynamic classes constructed in %.2f ms with %lld subobjects, %lld destroyed in %.2f ms"),
+        Total.NumConstructed, Rows.Num(), Total.ConstructionMs, Total.NumSubobjectsCreated, Total.NumDestroyed, Total.DestructionMs);
+    UE_LOG(LogSuzie, Display, TEXT("  Constructed  Construct ms   Avg us  Subobjects  Destroyed  Destroy ms  Class"));
+    for (int32 RowIndex = 0; RowIndex < FMath::Min(NumLoggedRows, Rows.Num()); RowIndex++)
+    {
+        const FClassRow& Row = Rows[RowIndex];
+        UE_LOG(LogSuzie, Display, TEXT("  %11lld  %12.2f  %7.2f  %10lld  %9lld  %10.2f  %s"), Row.NumConstructed, Row.ConstructionMs,
+            Row.NumConstructed > 0 ? Row.ConstructionMs * 1000.0 / Row.NumConstructed : 0.0, Row.NumSubobjectsCreated, Row.NumDestroyed, Row.DestructionMs, *Row.Stats->ClassPath);
+    }
+}
+
+void FSuzieConstructionStats::Reset()
+{
+    for (const auto& [ClassPath, Stats] : ClassConstructionStatsByPath)
+    {
+        Stats->NumConstructed.store(0, std::memory_order_relaxed);
+        Stats->ConstructionCycles.store(0, std::memory_order_relaxed);
+        Stats->NumSubobjectsCreated.store(0, std::memory_order_relaxed);
+        Stats->NumDestroyed.store(0, std::memory_order_relaxed);
+        Stats->DestructionCycles.store(0, std::memory_order_relaxed);
+    }
+}
+
+static FAutoConsoleCommand DumpConstructionStatsCommand(
+    TEXT("Suzie.DumpConstructionStats"),
+    TEXT("Logs the dynamic classes with the most expensive construction and destruction since the stats were last reset. Optional argument is the number of logged rows"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuzieConstructionStats::Dump(Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 20);
+    }));
+
+static FAutoConsoleCommand ResetConstructionStatsCommand(
+    TEXT("Suzie.ResetConstructionStats"),
+    TEXT("Resets the construction statistics of all dynamic classes"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuzieConstructionStats::Reset();
+    }));
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+// Stat group for objects of dynamic classes constructed and destroyed at runtime, shown with "stat Suzie"
+DECLARE_STATS_GROUP(TEXT("Suzie"), STATGROUP_Suzie, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dynamic Object Construction"), STAT_SuzieDynamicObjectConstruction, STATGROUP_Suzie, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dynamic Object Destruction"), STAT_SuzieDynamicObjectDestruction, STATGROUP_Suzie, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dynamic Objects Constructed"), STAT_SuzieDynamicObjectsConstructed, STATGROUP_Suzie, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dynamic Subobjects Created"), STAT_SuzieDynamicSubobjectsCreated, STATGROUP_Suzie, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dynamic Objects Destroyed"), STAT_SuzieDynamicObjectsDestroyed, STATGROUP_Suzie, );
+
+// Runtime counters of a single dynamic class. Objects can be constructed and destroyed on any thread, so the counters are atomic
+struct FSuzieClassConstructionStats
+{
+    FString ClassPath;
+    std::atomic<int64> NumConstructed{0};
+    std::atomic<uint64> ConstructionCycles{0};
+    std::atomic<int64> NumSubobjectsCreated{0};
+    std::atomic<int64> NumDestroyed{0};
+    std::atomic<uint64> DestructionCycles{0};
+};
+
+// Per-class construction statistics of dynamic classes. Collection is toggled with Suzie.ConstructionStats, and costs a single branch when disabled
+class FSuzieConstructionStats
+{
+public:
+    /** Returns true if per-class counters are currently being collected */
+    static bool IsEnabled();
+
+    /** Returns the counters of the class with the given path. Counters are kept by path so that they survive the class being regenerated by hot reload. Game thread only */
+    static TSharedRef<FSuzieClassConstructionStats> FindOrAddClassStats(const FString& ClassPath);
+
+    /** Returns the counters of all classes ever generated. Game thread only */
+    static TArray<TSharedRef<FSuzieClassConstructionStats>> GetAllClassStats();
+
+    /** Logs the classes with the most expensive construction */
+    static void Dump(int32 NumLoggedRows);
+    /** Resets the counters of all classes */
+    static void Reset();
+
+    /** Counts the construction of an object of the class and the time spent in its constructor, including the time spent constructing its subobjects */
+    class FScopedConstruction
+    {
+    public:
+        explicit FScopedConstruction(FSuzieClassConstructionStats* InStats);
+        ~FScopedConstruction();
+    private:
+        FSuzieClassConstructionStats* Stats{};
+        uint64 StartCycles{};
+    };
+
+    /** Counts the destruction of an object of the class and the time spent destroying its properties */
+    class FScopedDestruction
+    {
+    public:
+        explicit FScopedDestruction(FSuzieClassConstructionStats* InStats);
+        ~FScopedDestruction();
+    private:
+        FSuzieClassConstructionStats* Stats{};
+        uint64 StartCycles{};
+    };
+
+    static void CountSubobjectCreated(FSuzieClassConstructionStats* Stats);
+};
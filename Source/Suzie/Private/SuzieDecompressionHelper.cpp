@@ -1,10 +1,131 @@
 ﻿#include "SuzieDecompressionHelper.h"
+#include "SuziePlugin.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
 
 THIRD_PARTY_INCLUDES_START
 #include "zlib.h"
+#if WITH_SUZIE_ZSTD
+#include "zstd.h"
+#endif
 THIRD_PARTY_INCLUDES_END
 
-bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData)
+// Reads a little endian 32-bit integer, which is how all integers in Gzip headers and trailers are stored
+static uint32 ReadLittleEndianUInt32(const uint8* Data)
+{
+	return Data[0] | (Data[1] << 8) | (Data[2] << 16) | ((uint32)Data[3] << 24);
+}
+
+// Grows the decompression buffer when the size of the decompressed data was not known upfront. Returns false if the buffer cannot grow anymore
+static bool GrowDecompressionBuffer(TArray<uint8>& Buffer)
+{
+	if (Buffer.Num() == MAX_int32)
+	{
+		return false;
+	}
+	const int64 NewBufferSize = FMath::Min<int64>(FMath::Max<int64>((int64)Buffer.Num() * 2, 64 * 1024), MAX_int32);
+	Buffer.AddUninitialized((int32)(NewBufferSize - Buffer.Num()));
+	return true;
+}
+
+bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel)
+{
+	// Block-indexed files store the compressed size of each member in its header, so the members can be located without inflating them
+	TArray<FCompressedBlock> Members;
+	if (FindBlockGzipMembers(CompressedData, Members))
+	{
+		return DecompressBlocksParallel(Members, [&](const FCompressedBlock& Member, uint8* OutMemberData)
+		{
+			z_stream GzipStream;
+			GzipStream.zalloc = &FSuzieDecompressionHelper::ZlibAlloc;
+			GzipStream.zfree = &FSuzieDecompressionHelper::ZlibFree;
+			GzipStream.opaque = nullptr;
+			GzipStream.next_in = (uint8*)CompressedData.GetData() + Member.CompressedOffset;
+			GzipStream.avail_in = (uInt)Member.CompressedSize;
+			GzipStream.next_out = OutMemberData;
+			GzipStream.avail_out = (uInt)Member.DecompressedSize;
+
+			constexpr int32 GzipStreamEncoding = 16;
+			if (inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding) != Z_OK)
+			{
+				return false;
+			}
+			const int32 InflateStatusCode = inflate(&GzipStream, Z_FINISH);
+			const bool bDecompressedMember = InflateStatusCode == Z_STREAM_END && GzipStream.total_out == Member.DecompressedSize;
+			inflateEnd(&GzipStream);
+			return bDecompressedMember;
+		}, OutDecompressedData, bAllowParallel);
+	}
+	// Boundaries of other members are only known once the previous member has been inflated
+	return DecompressGzipSequential(CompressedData, OutDecompressedData);
+}
+
+bool FSuzieDecompressionHelper::FindBlockGzipMembers(const TArray<uint8>& CompressedData, TArray<FCompressedBlock>& OutMembers)
+{
+	constexpr int32 GzipHeaderSize = 10;
+	constexpr int32 GzipTrailerSize = 8;
+	constexpr uint8 GzipExtraFieldFlag = 4;
+
+	int64 CompressedOffset = 0;
+	int64 DecompressedOffset = 0;
+	while (CompressedOffset < CompressedData.Num())
+	{
+		// Every member must have the extra field with the block size, otherwise the file is a regular Gzip file
+		const uint8* MemberData = CompressedData.GetData() + CompressedOffset;
+		const int64 RemainingSize = CompressedData.Num() - CompressedOffset;
+		if (RemainingSize < GzipHeaderSize + 2 || MemberData[0] != 0x1F || MemberData[1] != 0x8B || MemberData[2] != Z_DEFLATED || (MemberData[3] & GzipExtraFieldFlag) == 0)
+		{
+			return false;
+		}
+		const int32 ExtraFieldSize = MemberData[GzipHeaderSize] | (MemberData[GzipHeaderSize + 1] << 8);
+		if (RemainingSize < GzipHeaderSize + 2 + ExtraFieldSize)
+		{
+			return false;
+		}
+
+		// Block size is stored in the BC subfield as the total size of the member minus one
+		int64 MemberSize = 0;
+		const uint8* SubfieldData = MemberData + GzipHeaderSize + 2;
+		const uint8* ExtraFieldEnd = SubfieldData + ExtraFieldSize;
+		while (SubfieldData + 4 <= ExtraFieldEnd)
+		{
+			const int32 SubfieldSize = SubfieldData[2] | (SubfieldData[3] << 8);
+			if (SubfieldData[0] == 'B' && SubfieldData[1] == 'C' && SubfieldSize == 2 && SubfieldData + 6 <= ExtraFieldEnd)
+			{
+				MemberSize = (SubfieldData[4] | (SubfieldData[5] << 8)) + 1;
+				break;
+			}
+			SubfieldData += 4 + SubfieldSize;
+		}
+		if (MemberSize < GzipHeaderSize + 2 + ExtraFieldSize + GzipTrailerSize || MemberSize > RemainingSize)
+		{
+			return false;
+		}
+
+		// Decompressed size of the member is stored in its trailer. Block-compressed members hold 64 KB at most, anything larger is not a valid block
+		constexpr uint32 MaxBlockDecompressedSize = 64 * 1024;
+		const uint32 MemberDecompressedSize = ReadLittleEndianUInt32(MemberData + MemberSize - 4);
+		if (MemberDecompressedSize > MaxBlockDecompressedSize)
+		{
+			return false;
+		}
+		FCompressedBlock& Member = OutMembers.AddDefaulted_GetRef();
+		Member.CompressedOffset = CompressedOffset;
+		Member.CompressedSize = MemberSize;
+		Member.DecompressedOffset = DecompressedOffset;
+		Member.DecompressedSize = MemberDecompressedSize;
+
+		CompressedOffset += MemberSize;
+		DecompressedOffset += Member.DecompressedSize;
+	}
+	return !OutMembers.IsEmpty();
+}
+
+bool FSuzieDecompressionHelper::DecompressGzipSequential(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData)
 {
 	z_stream GzipStream;
 	GzipStream.zalloc = &FSuzieDecompressionHelper::ZlibAlloc;
@@ -17,32 +138,352 @@ bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TArray<uint8>& Compre
 
 	// Init deflate settings to use GZIP
 	constexpr int32 GzipStreamEncoding = 16;
-	inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding);
+	if (inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding) != Z_OK)
+	{
+		return false;
+	}
 
-	uint8 LocalDecompressionBuffer[4096];
-	GzipStream.next_out = LocalDecompressionBuffer;
-	GzipStream.avail_out = sizeof(LocalDecompressionBuffer);
+	// Trailer of the last member has the decompressed size modulo 4 GB. It is exact for files with a single member, and the buffer grows if it is not.
+	// The trailer can be anything in a corrupt file, so the buffer is never made larger than what deflate can expand the file to (about 1032:1)
+	constexpr int64 MaxDeflateCompressionRatio = 1032;
+	const uint32 LastMemberDecompressedSize = CompressedData.Num() >= 4 ? ReadLittleEndianUInt32(CompressedData.GetData() + CompressedData.Num() - 4) : 0;
+	const int64 MaxDecompressedSize = FMath::Min<int64>((int64)CompressedData.Num() * MaxDeflateCompressionRatio, MAX_int32);
+	OutDecompressedData.SetNumUninitialized((int32)FMath::Clamp<int64>(LastMemberDecompressedSize, 1, MaxDecompressedSize));
 
-	int32 InflateStatusCode;
-	while ((InflateStatusCode = inflate(&GzipStream, Z_SYNC_FLUSH)) == Z_OK)
+	int64 DecompressedSize = 0;
+	int32 InflateStatusCode = Z_OK;
+	while (true)
 	{
-		// Append the number of bytes decompressed to the output
-		const int32 BytesWritten = sizeof(LocalDecompressionBuffer) - GzipStream.avail_out;
-		OutDecompressedData.Append(LocalDecompressionBuffer, BytesWritten);
+		if (DecompressedSize == OutDecompressedData.Num() && !GrowDecompressionBuffer(OutDecompressedData))
+		{
+			InflateStatusCode = Z_MEM_ERROR;
+			break;
+		}
+		GzipStream.next_out = OutDecompressedData.GetData() + DecompressedSize;
+		GzipStream.avail_out = (uInt)(OutDecompressedData.Num() - DecompressedSize);
 
-		// Reset the next byte to the start of the buffer and available space to the entire buffer
-		GzipStream.next_out = LocalDecompressionBuffer;
-		GzipStream.avail_out = sizeof(LocalDecompressionBuffer);
+		InflateStatusCode = inflate(&GzipStream, Z_NO_FLUSH);
+		DecompressedSize = OutDecompressedData.Num() - GzipStream.avail_out;
+
+		if (InflateStatusCode == Z_STREAM_END)
+		{
+			// Concatenated Gzip files are decompressed as a single file, same as the gzip tool does
+			if (GzipStream.avail_in >= 2 && GzipStream.next_in[0] == 0x1F && GzipStream.next_in[1] == 0x8B && inflateReset(&GzipStream) == Z_OK)
+			{
+				continue;
+			}
+			break;
+		}
+		// Inflate not making progress with space left in the output buffer means that the input is truncated
+		if (InflateStatusCode != Z_OK && !(InflateStatusCode == Z_BUF_ERROR && GzipStream.avail_out == 0))
+		{
+			break;
+		}
 	}
 	inflateEnd(&GzipStream);
 
-	// Append final decompressed bytes to the output
-	const int32 BytesWritten = sizeof(LocalDecompressionBuffer) - GzipStream.avail_out;
-	OutDecompressedData.Append(LocalDecompressionBuffer, BytesWritten);
-	
+	OutDecompressedData.SetNumUninitialized((int32)DecompressedSize);
 	return InflateStatusCode == Z_STREAM_END;
 }
 
+#if WITH_SUZIE_ZSTD
+bool FSuzieDecompressionHelper::DecompressMemoryZstd(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel)
+{
+	// Frame headers are read upfront to know where each frame ends and how large it is once decompressed
+	TArray<FCompressedBlock> Frames;
+	bool bAllFrameSizesKnown = true;
+	int64 CompressedOffset = 0;
+	int64 DecompressedOffset = 0;
+	while (CompressedOffset < CompressedData.Num())
+	{
+		const uint8* FrameData = CompressedData.GetData() + CompressedOffset;
+		const size_t RemainingSize = CompressedData.Num() - CompressedOffset;
+		const size_t FrameSize = ZSTD_findFrameCompressedSize(FrameData, RemainingSize);
+		if (ZSTD_isError(FrameSize))
+		{
+			return false;
+		}
+		const unsigned long long FrameContentSize = ZSTD_getFrameContentSize(FrameData, FrameSize);
+		if (FrameContentSize == ZSTD_CONTENTSIZE_ERROR)
+		{
+			return false;
+		}
+		bAllFrameSizesKnown &= FrameContentSize != ZSTD_CONTENTSIZE_UNKNOWN;
+
+		FCompressedBlock& Frame = Frames.AddDefaulted_GetRef();
+		Frame.CompressedOffset = CompressedOffset;
+		Frame.CompressedSize = FrameSize;
+		Frame.DecompressedOffset = DecompressedOffset;
+		Frame.DecompressedSize = bAllFrameSizesKnown ? FrameContentSize : 0;
+
+		CompressedOffset += FrameSize;
+		DecompressedOffset += Frame.DecompressedSize;
+	}
+
+	if (bAllFrameSizesKnown)
+	{
+		return DecompressBlocksParallel(Frames, [&](const FCompressedBlock& Frame, uint8* OutFrameData)
+		{
+			const size_t DecompressedFrameSize = ZSTD_decompress(OutFrameData, Frame.DecompressedSize, CompressedData.GetData() + Frame.CompressedOffset, Frame.CompressedSize);
+			return !ZSTD_isError(DecompressedFrameSize) && DecompressedFrameSize == (size_t)Frame.DecompressedSize;
+		}, OutDecompressedData, bAllowParallel);
+	}
+
+	// Streamed files do not have the content size in their headers, so they are decompressed as a stream into a growing buffer
+	ZSTD_DCtx* DecompressionContext = ZSTD_createDCtx();
+	if (DecompressionContext == nullptr)
+	{
+		return false;
+	}
+	OutDecompressedData.SetNumUninitialized((int32)FMath::Min<int64>((int64)CompressedData.Num() * 4, MAX_int32));
+
+	ZSTD_inBuffer InputBuffer{CompressedData.GetData(), (size_t)CompressedData.Num(), 0};
+	int64 DecompressedSize = 0;
+	size_t DecompressStatus = 0;
+	bool bOutputBufferFull = true;
+	while (InputBuffer.pos < InputBuffer.size || bOutputBufferFull)
+	{
+		if (DecompressedSize == OutDecompressedData.Num() && !GrowDecompressionBuffer(OutDecompressedData))
+		{
+			DecompressStatus = (size_t)-1;
+			break;
+		}
+		ZSTD_outBuffer OutputBuffer{OutDecompressedData.GetData() + DecompressedSize, (size_t)(OutDecompressedData.Num() - DecompressedSize), 0};
+		DecompressStatus = ZSTD_decompressStream(DecompressionContext, &OutputBuffer, &InputBuffer);
+		if (ZSTD_isError(DecompressStatus))
+		{
+			break;
+		}
+		DecompressedSize += OutputBuffer.pos;
+		bOutputBufferFull = OutputBuffer.pos == OutputBuffer.size;
+	}
+	ZSTD_freeDCtx(DecompressionContext);
+
+	OutDecompressedData.SetNumUninitialized((int32)DecompressedSize);
+	// Non-zero status after all input has been consumed means that the last frame is truncated
+	return DecompressStatus == 0;
+}
+#endif
+
+bool FSuzieDecompressionHelper::DecompressBlocksParallel(const TArray<FCompressedBlock>& Blocks, TFunctionRef<bool(const FCompressedBlock&, uint8*)> DecompressBlock, TArray<uint8>& OutDecompressedData, bool bAllowParallel)
+{
+	const int64 TotalDecompressedSize = Blocks.IsEmpty() ? 0 : Blocks.Last().DecompressedOffset + Blocks.Last().DecompressedSize;
+	if (TotalDecompressedSize > MAX_int32)
+	{
+		return false;
+	}
+	// Output buffer is allocated once, and each block is decompressed directly into its part of it
+	OutDecompressedData.SetNumUninitialized((int32)TotalDecompressedSize);
+
+	// Gzip blocks are at most 64 KB, so each task decompresses a range of blocks to keep the scheduling overhead low
+	const int32 NumTasks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() * 4, 1, Blocks.Num());
+	std::atomic<bool> bDecompressionFailed{false};
+	ParallelFor(NumTasks, [&](const int32 TaskIndex)
+	{
+		const int32 FirstBlockIndex = (int64)Blocks.Num() * TaskIndex / NumTasks;
+		const int32 LastBlockIndex = (int64)Blocks.Num() * (TaskIndex + 1) / NumTasks;
+		for (int32 BlockIndex = FirstBlockIndex; BlockIndex < LastBlockIndex && !bDecompressionFailed; BlockIndex++)
+		{
+			// Empty blocks (e.g. the end of file marker) have nothing to decompress
+			const FCompressedBlock& Block = Blocks[BlockIndex];
+			if (Block.DecompressedSize != 0 && !DecompressBlock(Block, OutDecompressedData.GetData() + Block.DecompressedOffset))
+			{
+				bDecompressionFailed = true;
+			}
+		}
+	}, bAllowParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	return !bDecompressionFailed;
+}
+
+// Size of the chunks read from and written to the archives when decompressing a stream
+static constexpr int32 DecompressionStreamChunkSize = 1024 * 1024;
+
+// Appends the next chunk of the reader to the bytes that have not been consumed yet, which are moved to the start of the buffer
+static void ReadNextStreamChunk(FArchive& Reader, TArray<uint8>& Buffer, int64& InOutNumUnconsumedBytes)
+{
+	if (InOutNumUnconsumedBytes > 0)
+	{
+		FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + Buffer.Num() - InOutNumUnconsumedBytes, InOutNumUnconsumedBytes);
+	}
+	const int64 ChunkSize = FMath::Min<int64>(DecompressionStreamChunkSize - InOutNumUnconsumedBytes, Reader.TotalSize() - Reader.Tell());
+	Buffer.SetNumUninitialized((int32)(InOutNumUnconsumedBytes + ChunkSize));
+	if (ChunkSize > 0)
+	{
+		Reader.Serialize(Buffer.GetData() + InOutNumUnconsumedBytes, ChunkSize);
+	}
+	InOutNumUnconsumedBytes += ChunkSize;
+}
+
+bool FSuzieDecompressionHelper::DecompressGzipStream(FArchive& Reader, FArchive& Writer)
+{
+	z_stream GzipStream{};
+	GzipStream.zalloc = &FSuzieDecompressionHelper::ZlibAlloc;
+	GzipStream.zfree = &FSuzieDecompressionHelper::ZlibFree;
+	GzipStream.opaque = nullptr;
+
+	constexpr int32 GzipStreamEncoding = 16;
+	if (inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding) != Z_OK)
+	{
+		return false;
+	}
+
+	TArray<uint8> InputBuffer;
+	TArray<uint8> OutputBuffer;
+	OutputBuffer.SetNumUninitialized(DecompressionStreamChunkSize);
+	int64 NumUnconsumedBytes = 0;
+	int32 InflateStatusCode = Z_OK;
+	bool bOutputBufferFull = false;
+	while (true)
+	{
+		// Start of the next member needs two bytes to be recognized, everything else can continue from any byte
+		const int64 NumNeededBytes = InflateStatusCode == Z_STREAM_END ? 2 : 1;
+		if (NumUnconsumedBytes < NumNeededBytes)
+		{
+			ReadNextStreamChunk(Reader, InputBuffer, NumUnconsumedBytes);
+			GzipStream.next_in = InputBuffer.GetData();
+			GzipStream.avail_in = (uInt)NumUnconsumedBytes;
+		}
+		if (InflateStatusCode == Z_STREAM_END)
+		{
+			// Concatenated Gzip files are decompressed as a single file, same as the gzip tool does
+			if (GzipStream.avail_in >= 2 && GzipStream.next_in[0] == 0x1F && GzipStream.next_in[1] == 0x8B && inflateReset(&GzipStream) == Z_OK)
+			{
+				InflateStatusCode = Z_OK;
+				continue;
+			}
+			break;
+		}
+		// Inflate can only make progress without new input while it has output left from the last call
+		if (GzipStream.avail_in == 0 && !bOutputBufferFull)
+		{
+			break;
+		}
+
+		GzipStream.next_out = OutputBuffer.GetData();
+		GzipStream.avail_out = (uInt)OutputBuffer.Num();
+		InflateStatusCode = inflate(&GzipStream, Z_NO_FLUSH);
+		NumUnconsumedBytes = GzipStream.avail_in;
+		Writer.Serialize(OutputBuffer.GetData(), OutputBuffer.Num() - GzipStream.avail_out);
+		bOutputBufferFull = GzipStream.avail_out == 0;
+
+		if (InflateStatusCode != Z_OK && InflateStatusCode != Z_STREAM_END && !(InflateStatusCode == Z_BUF_ERROR && GzipStream.avail_in == 0))
+		{
+			break;
+		}
+	}
+	inflateEnd(&GzipStream);
+	return InflateStatusCode == Z_STREAM_END && !Reader.IsError() && !Writer.IsError();
+}
+
+#if WITH_SUZIE_ZSTD
+bool FSuzieDecompressionHelper::DecompressZstdStream(FArchive& Reader, FArchive& Writer)
+{
+	ZSTD_DCtx* DecompressionContext = ZSTD_createDCtx();
+	if (DecompressionContext == nullptr)
+	{
+		return false;
+	}
+
+	TArray<uint8> InputChunk;
+	TArray<uint8> OutputChunk;
+	OutputChunk.SetNumUninitialized(DecompressionStreamChunkSize);
+	ZSTD_inBuffer InputBuffer{nullptr, 0, 0};
+	size_t DecompressStatus = 0;
+	bool bOutputBufferFull = false;
+	while (true)
+	{
+		if (InputBuffer.pos == InputBuffer.size)
+		{
+			int64 NumUnconsumedBytes = 0;
+			ReadNextStreamChunk(Reader, InputChunk, NumUnconsumedBytes);
+			InputBuffer = ZSTD_inBuffer{InputChunk.GetData(), (size_t)NumUnconsumedBytes, 0};
+			// Decompressor can only make progress without new input while it has output left from the last call
+			if (NumUnconsumedBytes == 0 && !bOutputBufferFull)
+			{
+				break;
+			}
+		}
+		ZSTD_outBuffer OutputBuffer{OutputChunk.GetData(), (size_t)OutputChunk.Num(), 0};
+		DecompressStatus = ZSTD_decompressStream(DecompressionContext, &OutputBuffer, &InputBuffer);
+		if (ZSTD_isError(DecompressStatus))
+		{
+			break;
+		}
+		Writer.Serialize(OutputChunk.GetData(), OutputBuffer.pos);
+		bOutputBufferFull = OutputBuffer.pos == OutputBuffer.size;
+	}
+	ZSTD_freeDCtx(DecompressionContext);
+
+	// Non-zero status after all input has been consumed means that the last frame is truncated
+	return DecompressStatus == 0 && !Reader.IsError() && !Writer.IsError();
+}
+#endif
+
+bool FSuzieDecompressionHelper::DecompressFileToArchive(const FString& FilePath, FArchive& Writer)
+{
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+#if WITH_SUZIE_ZSTD
+	if (FilePath.EndsWith(TEXT(".zst")))
+	{
+		return DecompressZstdStream(*Reader, Writer);
+	}
+#endif
+	if (FilePath.EndsWith(TEXT(".gz")))
+	{
+		return DecompressGzipStream(*Reader, Writer);
+	}
+	return false;
+}
+
+bool FSuzieDecompressionHelper::DecompressMemoryForFileName(const FString& FileName, const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel)
+{
+#if WITH_SUZIE_ZSTD
+	if (FileName.EndsWith(TEXT(".zst")))
+	{
+		return DecompressMemoryZstd(CompressedData, OutDecompressedData, bAllowParallel);
+	}
+#endif
+	if (FileName.EndsWith(TEXT(".gz")))
+	{
+		return DecompressMemoryGzip(CompressedData, OutDecompressedData, bAllowParallel);
+	}
+	return false;
+}
+
+const TArray<FString>& FSuzieDecompressionHelper::GetCompressedFileExtensions()
+{
+	static const TArray<FString> CompressedFileExtensions = {
+		TEXT(".gz"),
+#if WITH_SUZIE_ZSTD
+		TEXT(".zst"),
+#endif
+	};
+	return CompressedFileExtensions;
+}
+
+bool FSuzieDecompressionHelper::IsCompressedFileName(const FString& FileName)
+{
+	return GetCompressedFileExtensions().ContainsByPredicate([&](const FString& Extension) { return FileName.EndsWith(Extension); });
+}
+
+FString FSuzieDecompressionHelper::RemoveCompressedFileExtension(const FString& FileName)
+{
+	FString FileNameWithoutExtension = FileName;
+	for (const FString& Extension : GetCompressedFileExtensions())
+	{
+		if (FileNameWithoutExtension.RemoveFromEnd(Extension))
+		{
+			break;
+		}
+	}
+	return FileNameWithoutExtension;
+}
+
 void* FSuzieDecompressionHelper::ZlibAlloc(void*, unsigned int size, unsigned int num)
 {
 	return FMemory::Malloc(size * num);
@@ -52,3 +493,77 @@ void FSuzieDecompressionHelper::ZlibFree(void*, void* p)
 {
 	FMemory::Free(p);
 }
+
+// Measures how fast each available format of the same dump is read and decompressed, e.g. Game.jmap, Game.jmap.gz and Game.jmap.zst
+static FAutoConsoleCommand BenchmarkDecompressionCommand(
+	TEXT("Suzie.BenchmarkDecompression"),
+	TEXT("Measures decompression throughput of all formats of a dump in the DynamicClasses directory, single threaded and in parallel. Arguments are the dump name (e.g. Game) and optionally the number of iterations"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.IsEmpty())
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Usage: Suzie.BenchmarkDecompression <DumpName> [Iterations]"));
+			return;
+		}
+		const FString DumpFileName = Args[0] + TEXT(".jmap");
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 3;
+		const FString JsonClassesPath = FSuziePluginModule::GetJsonClassDefinitionsDirectory();
+
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *(JsonClassesPath / DumpFileName + TEXT("*")), true, false);
+		FileNames.RemoveAll([&](const FString& FileName) { return FSuzieDecompressionHelper::RemoveCompressedFileExtension(FileName) != DumpFileName; });
+		if (FileNames.IsEmpty())
+		{
+			UE_LOG(LogSuzie, Error, TEXT("No supported files found for dump %s in %s"), *Args[0], *JsonClassesPath);
+			return;
+		}
+
+		for (const FString& FileName : FileNames)
+		{
+			TArray<uint8> FileContents;
+			const double ReadStartTime = FPlatformTime::Seconds();
+			if (!FFileHelper::LoadFileToArray(FileContents, *(JsonClassesPath / FileName)))
+			{
+				UE_LOG(LogSuzie, Error, TEXT("Failed to read %s"), *FileName);
+				continue;
+			}
+			const double ReadTime = FPlatformTime::Seconds() - ReadStartTime;
+			constexpr double BytesPerMegabyte = 1024.0 * 1024.0;
+
+			if (!FSuzieDecompressionHelper::IsCompressedFileName(FileName))
+			{
+				UE_LOG(LogSuzie, Display, TEXT("%s: %.1f MB, read in %.1f ms"), *FileName, FileContents.Num() / BytesPerMegabyte, ReadTime * 1000.0);
+				continue;
+			}
+
+			auto MeasureAverageDecompressionTime = [&](const bool bAllowParallel, int32& OutDecompressedSize)
+			{
+				double TotalTime = 0.0;
+				for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+				{
+					TArray<uint8> DecompressedContents;
+					const double StartTime = FPlatformTime::Seconds();
+					if (!FSuzieDecompressionHelper::DecompressMemoryForFileName(FileName, FileContents, DecompressedContents, bAllowParallel))
+					{
+						return -1.0;
+					}
+					TotalTime += FPlatformTime::Seconds() - StartTime;
+					OutDecompressedSize = DecompressedContents.Num();
+				}
+				return TotalTime / NumIterations;
+			};
+
+			int32 DecompressedSize = 0;
+			const double SingleThreadedTime = MeasureAverageDecompressionTime(false, DecompressedSize);
+			const double ParallelTime = MeasureAverageDecompressionTime(true, DecompressedSize);
+			if (SingleThreadedTime < 0.0 || ParallelTime < 0.0)
+			{
+				UE_LOG(LogSuzie, Error, TEXT("Failed to decompress %s"), *FileName);
+				continue;
+			}
+			const double DecompressedMegabytes = DecompressedSize / BytesPerMegabyte;
+			UE_LOG(LogSuzie, Display, TEXT("%s: %.1f MB (%.1f MB decompressed), read in %.1f ms, decompressed in %.1f ms (%.0f MB/s) single threaded and %.1f ms (%.0f MB/s) in parallel, average of %d iterations"),
+				*FileName, FileContents.Num() / BytesPerMegabyte, DecompressedMegabytes, ReadTime * 1000.0,
+				SingleThreadedTime * 1000.0, DecompressedMegabytes / SingleThreadedTime, ParallelTime * 1000.0, DecompressedMegabytes / ParallelTime, NumIterations);
+		}
+	}));
@@ -5,9 +5,39 @@
 class FSuzieDecompressionHelper
 {
 public:
-	/** Decompresses memory with Gzip */
-	static bool DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData);
+	/** Decompresses memory with Gzip. Concatenated members are supported, and members of block-indexed (BGZF) files are decompressed in parallel */
+	static bool DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel = true);
+#if WITH_SUZIE_ZSTD
+	/** Decompresses memory with Zstandard. Frames are decompressed in parallel when all of them have their content size in the header */
+	static bool DecompressMemoryZstd(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel = true);
+#endif
+	/** Decompresses memory with the format matching the extension of the file name */
+	static bool DecompressMemoryForFileName(const FString& FileName, const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData, bool bAllowParallel = true);
+	/** Decompresses the file with the format matching its extension into the writer one chunk at a time, so that neither the compressed nor the decompressed data is held in memory */
+	static bool DecompressFileToArchive(const FString& FilePath, FArchive& Writer);
+
+	/** Returns extensions of the supported compressed file formats, e.g. .gz */
+	static const TArray<FString>& GetCompressedFileExtensions();
+	/** Returns true if the file name ends with one of the supported compressed file extensions */
+	static bool IsCompressedFileName(const FString& FileName);
+	/** Returns the file name without the compressed file extension, e.g. Game.jmap for Game.jmap.gz */
+	static FString RemoveCompressedFileExtension(const FString& FileName);
 private:
+	struct FCompressedBlock
+	{
+		int64 CompressedOffset{};
+		int64 CompressedSize{};
+		int64 DecompressedOffset{};
+		int64 DecompressedSize{};
+	};
+
+	static bool FindBlockGzipMembers(const TArray<uint8>& CompressedData, TArray<FCompressedBlock>& OutMembers);
+	static bool DecompressGzipSequential(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData);
+	static bool DecompressGzipStream(FArchive& Reader, FArchive& Writer);
+#if WITH_SUZIE_ZSTD
+	static bool DecompressZstdStream(FArchive& Reader, FArchive& Writer);
+#endif
+	static bool DecompressBlocksParallel(const TArray<FCompressedBlock>& Blocks, TFunctionRef<bool(const FCompressedBlock&, uint8*)> DecompressBlock, TArray<uint8>& OutDecompressedData, bool bAllowParallel);
 	static void* ZlibAlloc(void* opaque, unsigned int size, unsigned int num);
 	static void ZlibFree(void* opaque, void* p);
 };
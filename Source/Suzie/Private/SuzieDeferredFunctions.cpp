@@ -0,0 +1,167 @@
+#include "SuziePlugin.h"
+#include "SuzieTrace.h"
+#include "BlueprintActionDatabase.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/UObjectHash.h"
+
+// Time spent creating deferred functions per editor tick. Functions are created class by class, so a single tick can take slightly longer
+static constexpr double DeferredFunctionTimeBudgetPerTick = 0.005;
+
+void FSuziePluginModule::BeginMaterializingDeferredFunctions(const TSharedPtr<FJsonObject>& Objects)
+{
+    // Definitions of the functions reference other objects (e.g. delegate signatures), so the entire map is needed to create them
+    DeferredFunctionObjectMap = Objects;
+
+    int32 NumDeferredFunctions = 0;
+    for (const auto& [Class, FunctionPaths] : DeferredClassFunctions)
+    {
+        NumDeferredFunctions += FunctionPaths.Num();
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Deferred creation of %d functions in %d classes"), NumDeferredFunctions, DeferredClassFunctions.Num());
+
+    if (!DeferredFunctionTickerHandle.IsValid())
+    {
+        DeferredFunctionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSuziePluginModule::MaterializeDeferredFunctionsOnIdle));
+    }
+
+    // Loaded Blueprints can override or call any function of their parent classes, and the running game can call any of them
+    if (!DeferredFunctionSyncLoadHandle.IsValid())
+    {
+        DeferredFunctionSyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddLambda([this](const FString&) { FlushDeferredFunctions(); });
+    }
+    // Async loads are requested before any of their packages are loaded, so flushing here means no linker can resolve a function import before it exists.
+    // The ticker does not create functions while async loading, so it would not help once the load has started
+    if (!DeferredFunctionAsyncLoadHandle.IsValid())
+    {
+        DeferredFunctionAsyncLoadHandle = FCoreUObjectDelegates::OnAsyncLoadPackage.AddLambda([this](const FString&)
+        {
+            // Functions can only be created on the game thread, which is where nearly all async loads are requested from
+            if (IsInGameThread())
+            {
+                FlushDeferredFunctions();
+            }
+        });
+    }
+    if (!DeferredFunctionPreBeginPIEHandle.IsValid())
+    {
+        DeferredFunctionPreBeginPIEHandle = FEditorDelegates::PreBeginPIE.AddLambda([this](const bool) { FlushDeferredFunctions(); });
+    }
+    UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+    if (AssetEditorSubsystem && !DeferredFunctionAssetEditorHandle.IsValid())
+    {
+        DeferredFunctionAssetEditorHandle = AssetEditorSubsystem->OnAssetEditorRequestedOpen().AddLambda([this](UObject*) { FlushDeferredFunctions(); });
+    }
+}
+
+void FSuziePluginModule::MaterializeDeferredFunctions(const double TimeBudgetSeconds)
+{
+    LLM_SCOPE_BYTAG(Suzie);
+    if (DeferredClassFunctions.IsEmpty())
+    {
+        return;
+    }
+    const double StartTime = FPlatformTime::Seconds();
+
+    FDynamicClassGenerationContext ClassGenerationContext;
+    ClassGenerationContext.GlobalObjectMap = DeferredFunctionObjectMap;
+    ClassGenerationContext.SkippedObjectPaths = &SkippedObjectPaths;
+    SetupOnDemandObjectDefinitions(ClassGenerationContext);
+
+    TArray<UClass*> MaterializedClasses;
+    for (auto It = DeferredClassFunctions.CreateIterator(); It; ++It)
+    {
+        for (const FString& FunctionPath : It.Value())
+        {
+            AddFunctionToClass(ClassGenerationContext, It.Key(), FunctionPath);
+        }
+        MaterializedClasses.Add(It.Key());
+        It.RemoveCurrent();
+
+        if (FPlatformTime::Seconds() - StartTime > TimeBudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    FlushPendingMetaData(ClassGenerationContext);
+
+    for (UClass* MaterializedClass : MaterializedClasses)
+    {
+        // Classes cache function lookups, including lookups of inherited functions in their child classes
+        MaterializedClass->ClearFunctionMapsCaches();
+        TArray<UClass*> DerivedClasses;
+        GetDerivedClasses(MaterializedClass, DerivedClasses);
+        for (UClass* DerivedClass : DerivedClasses)
+        {
+            DerivedClass->ClearFunctionMapsCaches();
+        }
+
+        // Blueprint actions of the class might have been gathered before its functions existed
+        FBlueprintActionDatabase::Get().RefreshClassActions(MaterializedClass);
+    }
+
+    // Nothing else will need the definitions once all functions have been created
+    if (DeferredClassFunctions.IsEmpty())
+    {
+        DeferredFunctionObjectMap.Reset();
+        UE_LOG(LogSuzie, Display, TEXT("Finished creating deferred functions"));
+    }
+}
+
+void FSuziePluginModule::FlushDeferredFunctions()
+{
+    MaterializeDeferredFunctions(DBL_MAX);
+    StopMaterializingDeferredFunctions();
+}
+
+bool FSuziePluginModule::MaterializeDeferredFunctionsOnIdle(float DeltaTime)
+{
+    // Creating functions while a package is being loaded could run into half loaded Blueprints
+    if (IsGarbageCollecting() || IsAsyncLoading())
+    {
+        return true;
+    }
+    MaterializeDeferredFunctions(DeferredFunctionTimeBudgetPerTick);
+    if (!DeferredClassFunctions.IsEmpty())
+    {
+        return true;
+    }
+    // Ticker is removed by returning false, so only the delegates need to be removed here
+    DeferredFunctionTickerHandle.Reset();
+    StopMaterializingDeferredFunctions();
+    return false;
+}
+
+void FSuziePluginModule::StopMaterializingDeferredFunctions()
+{
+    if (DeferredFunctionTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(DeferredFunctionTickerHandle);
+        DeferredFunctionTickerHandle.Reset();
+    }
+    if (DeferredFunctionSyncLoadHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnSyncLoadPackage.Remove(DeferredFunctionSyncLoadHandle);
+        DeferredFunctionSyncLoadHandle.Reset();
+    }
+    if (DeferredFunctionAsyncLoadHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnAsyncLoadPackage.Remove(DeferredFunctionAsyncLoadHandle);
+        DeferredFunctionAsyncLoadHandle.Reset();
+    }
+    if (DeferredFunctionPreBeginPIEHandle.IsValid())
+    {
+        FEditorDelegates::PreBeginPIE.Remove(DeferredFunctionPreBeginPIEHandle);
+        DeferredFunctionPreBeginPIEHandle.Reset();
+    }
+    if (DeferredFunctionAssetEditorHandle.IsValid())
+    {
+        if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+        {
+            AssetEditorSubsystem->OnAssetEditorRequestedOpen().Remove(DeferredFunctionAssetEditorHandle);
+        }
+        DeferredFunctionAssetEditorHandle.Reset();
+    }
+}
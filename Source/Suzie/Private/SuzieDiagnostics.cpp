@@ -0,0 +1,55 @@
+#include "SuziePlugin.h"
+#include "SSuzieDiagnostics.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "HAL/IConsoleManager.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "Widgets/Docking/SDockTab.h"
+
+#define LOCTEXT_NAMESPACE "FSuziePluginModule"
+
+static const FName SuzieDiagnosticsTabName(TEXT("SuzieDiagnostics"));
+
+void FSuziePluginModule::RegisterDiagnosticsTab()
+{
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SuzieDiagnosticsTabName, FOnSpawnTab::CreateRaw(this, &FSuziePluginModule::SpawnDiagnosticsTab))
+        .SetDisplayName(LOCTEXT("DiagnosticsTabTitle", "Suzie Diagnostics"))
+        .SetTooltipText(LOCTEXT("DiagnosticsTabTooltip", "Shows how long the last generation of dynamic types took, how much memory they use and which types could not be found"))
+        .SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsMiscCategory());
+}
+
+void FSuziePluginModule::UnregisterDiagnosticsTab()
+{
+    if (FSlateApplication::IsInitialized())
+    {
+        FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SuzieDiagnosticsTabName);
+    }
+}
+
+TSharedRef<SDockTab> FSuziePluginModule::SpawnDiagnosticsTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+    return SNew(SDockTab)
+        .TabRole(ETabRole::NomadTab)
+        [
+            SNew(SSuzieDiagnostics)
+        ];
+}
+
+void FSuziePluginModule::OpenDiagnosticsTab()
+{
+    if (FSlateApplication::IsInitialized())
+    {
+        FGlobalTabmanager::Get()->TryInvokeTab(SuzieDiagnosticsTabName);
+    }
+}
+
+static FAutoConsoleCommand DiagnosticsCommand(
+    TEXT("Suzie.Diagnostics"),
+    TEXT("Opens the Suzie Diagnostics tab, which shows the timings, memory, construction counters and type fallbacks of the last generation. Also available in Tools > Debug"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuziePluginModule::OpenDiagnosticsTab();
+    }));
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,428 @@
+#include "SuzieDumpSnapshot.h"
+#include "SuziePlugin.h"
+#include "SuzieTrace.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "SuzieJsonDumpParser.h"
+
+static constexpr uint32 DumpSnapshotMagic = 0x535A5553; // SUZS
+// Bump when the layout of the snapshot changes, so that snapshots written by older versions are recreated instead of misread
+static constexpr int32 DumpSnapshotVersion = 2;
+
+bool FSuzieDumpSnapshot::Save(const FString& FilePath, const FSHAHash& InputHash, const TSharedPtr<FJsonObject>& RootObject, const TSet<FString>& SkippedObjectPaths)
+{
+    SUZIE_TRACE_SCOPE(SaveDumpSnapshot);
+    const TSharedPtr<FJsonValue> RootValue = MakeShared<FJsonValueObject>(RootObject);
+
+    // Field names and most string values repeat across thousands of objects, so each unique string is only written once
+    FStringIndexMap StringIndices;
+    GatherStrings(RootValue, StringIndices);
+    for (const FString& SkippedObjectPath : SkippedObjectPaths)
+    {
+        StringIndices.FindOrAdd(SkippedObjectPath, StringIndices.Num());
+    }
+
+    // Write to a temporary file first so that an interrupted write never leaves a truncated snapshot behind
+    const FString TempFilePath = FilePath + TEXT(".tmp");
+    const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Failed to create dump snapshot: %s"), *TempFilePath);
+        return false;
+    }
+    uint32 Magic = DumpSnapshotMagic;
+    int32 Version = DumpSnapshotVersion;
+    FSHAHash Hash = InputHash;
+    *Writer << Magic << Version << Hash;
+
+    TArray<const FString*> Strings;
+    Strings.SetNumZeroed(StringIndices.Num());
+    for (const auto& [String, StringIndex] : StringIndices)
+    {
+        Strings[StringIndex] = &String;
+    }
+    int32 NumStrings = Strings.Num();
+    *Writer << NumStrings;
+    for (const FString* String : Strings)
+    {
+        *Writer << const_cast<FString&>(*String);
+    }
+
+    int32 NumSkippedObjectPaths = SkippedObjectPaths.Num();
+    *Writer << NumSkippedObjectPaths;
+    for (const FString& SkippedObjectPath : SkippedObjectPaths)
+    {
+        int32 StringIndex = StringIndices.FindChecked(SkippedObjectPath);
+        *Writer << StringIndex;
+    }
+    WriteValue(*Writer, RootValue, StringIndices);
+
+    const bool bWriteSucceeded = !Writer->IsError() && Writer->Close();
+    if (!bWriteSucceeded || !IFileManager::Get().Move(*FilePath, *TempFilePath))
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Failed to write dump snapshot: %s"), *FilePath);
+        IFileManager::Get().Delete(*TempFilePath);
+        return false;
+    }
+    return true;
+}
+
+bool FSuzieDumpSnapshot::Load(const FString& FilePath, const FSHAHash& InputHash, TSharedPtr<FJsonObject>& OutRootObject, TSet<FString>& OutSkippedObjectPaths)
+{
+    // Check the header first, so that a stale snapshot does not need to be read in full
+    {
+        const TUniquePtr<FArchive> HeaderReader(IFileManager::Get().CreateFileReader(*FilePath));
+        if (!HeaderReader)
+        {
+            return false;
+        }
+        uint32 Magic = 0;
+        int32 Version = 0;
+        FSHAHash Hash;
+        *HeaderReader << Magic << Version << Hash;
+        if (HeaderReader->IsError() || Magic != DumpSnapshotMagic || Version != DumpSnapshotVersion || Hash != InputHash)
+        {
+            return false;
+        }
+    }
+
+    SUZIE_TRACE_SCOPE(LoadDumpSnapshot);
+    TArray<uint8> SnapshotData;
+    if (!FFileHelper::LoadFileToArray(SnapshotData, *FilePath))
+    {
+        return false;
+    }
+    FMemoryReader Reader(SnapshotData);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    FSHAHash Hash;
+    Reader << Magic << Version << Hash;
+
+    int32 NumStrings = 0;
+    Reader << NumStrings;
+    if (Reader.IsError() || NumStrings < 0 || NumStrings > Reader.TotalSize() - Reader.Tell())
+    {
+        return false;
+    }
+    TArray<FString> Strings;
+    Strings.SetNum(NumStrings);
+    for (FString& String : Strings)
+    {
+        Reader << String;
+    }
+
+    int32 NumSkippedObjectPaths = 0;
+    Reader << NumSkippedObjectPaths;
+    if (Reader.IsError() || NumSkippedObjectPaths < 0 || NumSkippedObjectPaths > Reader.TotalSize() - Reader.Tell())
+    {
+        return false;
+    }
+    TSet<FString> SkippedObjectPaths;
+    SkippedObjectPaths.Reserve(NumSkippedObjectPaths);
+    for (int32 Index = 0; Index < NumSkippedObjectPaths; Index++)
+    {
+        int32 StringIndex = INDEX_NONE;
+        Reader << StringIndex;
+        if (!Strings.IsValidIndex(StringIndex))
+        {
+            return false;
+        }
+        SkippedObjectPaths.Add(Strings[StringIndex]);
+    }
+
+    const TSharedPtr<FJsonValue> RootValue = ReadValue(Reader, Strings);
+    if (!RootValue.IsValid() || RootValue->Type != EJson::Object || Reader.IsError())
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Dump snapshot is corrupted and will be recreated: %s"), *FilePath);
+        return false;
+    }
+    OutRootObject = RootValue->AsObject();
+    OutSkippedObjectPaths.Append(MoveTemp(SkippedObjectPaths));
+    return true;
+}
+
+void FSuzieDumpSnapshot::GatherStrings(const TSharedPtr<FJsonValue>& Value, FStringIndexMap& StringIndices)
+{
+    switch (Value->Type)
+    {
+    case EJson::String:
+        StringIndices.FindOrAdd(Value->AsString(), StringIndices.Num());
+        break;
+    case EJson::Array:
+        for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+        {
+            GatherStrings(Element, StringIndices);
+        }
+        break;
+    case EJson::Object:
+        for (const auto& [FieldName, FieldValue] : Value->AsObject()->Values)
+        {
+            StringIndices.FindOrAdd(FieldName, StringIndices.Num());
+            GatherStrings(FieldValue, StringIndices);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void FSuzieDumpSnapshot::WriteValue(FArchive& Ar, const TSharedPtr<FJsonValue>& Value, const FStringIndexMap& StringIndices)
+{
+    uint8 Type = static_cast<uint8>(Value->Type);
+    Ar << Type;
+    switch (Value->Type)
+    {
+    case EJson::String:
+        {
+            int32 StringIndex = StringIndices.FindChecked(Value->AsString());
+            Ar << StringIndex;
+            break;
+        }
+    case EJson::Number:
+        {
+            double Number = Value->AsNumber();
+            Ar << Number;
+            break;
+        }
+    case EJson::Boolean:
+        {
+            bool bValue = Value->AsBool();
+            Ar << bValue;
+            break;
+        }
+    case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+            int32 NumElements = Elements.Num();
+            Ar << NumElements;
+            for (const TSharedPtr<FJsonValue>& Element : Elements)
+            {
+                WriteValue(Ar, Element, StringIndices);
+            }
+            break;
+        }
+    case EJson::Object:
+        {
+            const TMap<FString, TSharedPtr<FJsonValue>>& Fields = Value->AsObject()->Values;
+            int32 NumFields = Fields.Num();
+            Ar << NumFields;
+            for (const auto& [FieldName, FieldValue] : Fields)
+            {
+                int32 FieldNameIndex = StringIndices.FindChecked(FieldName);
+                Ar << FieldNameIndex;
+                WriteValue(Ar, FieldValue, StringIndices);
+            }
+            break;
+        }
+    default:
+        break;
+    }
+}
+
+TSharedPtr<FJsonValue> FSuzieDumpSnapshot::ReadValue(FArchive& Ar, const TArray<FString>& Strings)
+{
+    uint8 Type = 0;
+    Ar << Type;
+    if (Ar.IsError())
+    {
+        return nullptr;
+    }
+    switch (static_cast<EJson>(Type))
+    {
+    case EJson::Null:
+        return MakeShared<FJsonValueNull>();
+    case EJson::String:
+        {
+            int32 StringIndex = INDEX_NONE;
+            Ar << StringIndex;
+            return Strings.IsValidIndex(StringIndex) ? MakeShared<FJsonValueString>(Strings[StringIndex]) : nullptr;
+        }
+    case EJson::Number:
+        {
+            double Number = 0.0;
+            Ar << Number;
+            return MakeShared<FJsonValueNumber>(Number);
+        }
+    case EJson::Boolean:
+        {
+            bool bValue = false;
+            Ar << bValue;
+            return MakeShared<FJsonValueBoolean>(bValue);
+        }
+    case EJson::Array:
+        {
+            // Every element takes at least one byte, which keeps corrupted counts from allocating huge arrays
+            int32 NumElements = 0;
+            Ar << NumElements;
+            if (Ar.IsError() || NumElements < 0 || NumElements > Ar.TotalSize() - Ar.Tell())
+            {
+                return nullptr;
+            }
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            Elements.Reserve(NumElements);
+            for (int32 ElementIndex = 0; ElementIndex < NumElements; ElementIndex++)
+            {
+                TSharedPtr<FJsonValue> Element = ReadValue(Ar, Strings);
+                if (!Element.IsValid())
+                {
+                    return nullptr;
+                }
+                Elements.Add(MoveTemp(Element));
+            }
+            return MakeShared<FJsonValueArray>(Elements);
+        }
+    case EJson::Object:
+        {
+            int32 NumFields = 0;
+            Ar << NumFields;
+            if (Ar.IsError() || NumFields < 0 || NumFields > Ar.TotalSize() - Ar.Tell())
+            {
+                return nullptr;
+            }
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            Object->Values.Reserve(NumFields);
+            for (int32 FieldIndex = 0; FieldIndex < NumFields; FieldIndex++)
+            {
+                int32 FieldNameIndex = INDEX_NONE;
+                Ar << FieldNameIndex;
+                TSharedPtr<FJsonValue> FieldValue = Strings.IsValidIndex(FieldNameIndex) ? ReadValue(Ar, Strings) : nullptr;
+                if (!FieldValue.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->Values.Add(Strings[FieldNameIndex], MoveTemp(FieldValue));
+            }
+            return MakeShared<FJsonValueObject>(Object);
+        }
+    default:
+        return nullptr;
+    }
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Compares the values including all of their nested values. Strings and field names are compared case-sensitively, and fields have to be in the same order
+static bool AreJsonValuesIdentical(const TSharedPtr<FJsonValue>& A, const TSharedPtr<FJsonValue>& B)
+{
+    if (!A.IsValid() || !B.IsValid())
+    {
+        return A.IsValid() == B.IsValid();
+    }
+    if (A->Type != B->Type)
+    {
+        return false;
+    }
+    switch (A->Type)
+    {
+    case EJson::String:
+        return A->AsString().Equals(B->AsString(), ESearchCase::CaseSensitive);
+    case EJson::Number:
+        return A->AsNumber() == B->AsNumber();
+    case EJson::Boolean:
+        return A->AsBool() == B->AsBool();
+    case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& ElementsA = A->AsArray();
+            const TArray<TSharedPtr<FJsonValue>>& ElementsB = B->AsArray();
+            if (ElementsA.Num() != ElementsB.Num())
+            {
+                return false;
+            }
+            for (int32 ElementIndex = 0; ElementIndex < ElementsA.Num(); ElementIndex++)
+            {
+                if (!AreJsonValuesIdentical(ElementsA[ElementIndex], ElementsB[ElementIndex]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    case EJson::Object:
+        {
+            const TMap<FString, TSharedPtr<FJsonValue>>& FieldsA = A->AsObject()->Values;
+            const TMap<FString, TSharedPtr<FJsonValue>>& FieldsB = B->AsObject()->Values;
+            if (FieldsA.Num() != FieldsB.Num())
+            {
+                return false;
+            }
+            for (auto ItA = FieldsA.CreateConstIterator(), ItB = FieldsB.CreateConstIterator(); ItA; ++ItA, ++ItB)
+            {
+                if (!ItA.Key().Equals(ItB.Key(), ESearchCase::CaseSensitive) || !AreJsonValuesIdentical(ItA.Value(), ItB.Value()))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    default:
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSuzieDumpSnapshotRoundTripTest, "Suzie.DumpSnapshot.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSuzieDumpSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+    // Strings that only differ in case are common in dumps (field names and values, enum constants, object paths), and must stay distinct
+    const FString DumpContent = TEXT(R"json({
+        "objects": {
+            "/Script/Game.Weapon": {
+                "type": "Class",
+                "super_struct": "/Script/Engine.Actor",
+                "properties": [
+                    {"name": "Type", "type": "EnumProperty", "enum": "/Script/Game.EWeaponType", "offset": 680, "flags": 4503599627370497},
+                    {"name": "bIsAuto", "type": "BoolProperty", "field_size": 1, "byte_offset": 0, "field_mask": 4, "offset": 684}
+                ]
+            },
+            "/Script/Game.EWeaponType": {
+                "type": "Enum",
+                "names": [["EWeaponType::Rifle", 0], ["EWeaponType::RIFLE", 1], ["EWeaponType::rifle", 2]]
+            },
+            "/Script/Game.Default__Weapon": {
+                "type": "Object",
+                "class": "/Script/Game.Weapon",
+                "properties": {"Type": "EWeaponType::RIFLE", "Label": "type", "Alias": "/script/game.weapon", "Missing": null}
+            }
+        }
+    })json");
+
+    TSharedPtr<FJsonObject> ParsedRootObject;
+    TSet<FString> SkippedObjectPaths;
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Dump is parsed"), FSuzieJsonDumpParser::ParseDump(DumpContent, [](const FString&) { return false; }, ParsedRootObject, SkippedObjectPaths, ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    SkippedObjectPaths.Add(TEXT("/Script/Skipped.Skipped"));
+
+    const FString SnapshotFilePath = FPaths::AutomationTransientDir() / TEXT("SuzieDumpSnapshotRoundTrip.bin");
+    FSHAHash InputHash;
+    FSHA1::HashBuffer(*DumpContent, DumpContent.Len() * sizeof(TCHAR), InputHash.Hash);
+    if (!TestTrue(TEXT("Snapshot is saved"), FSuzieDumpSnapshot::Save(SnapshotFilePath, InputHash, ParsedRootObject, SkippedObjectPaths)))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> LoadedRootObject;
+    TSet<FString> LoadedSkippedObjectPaths;
+    FSHAHash OtherInputHash = InputHash;
+    OtherInputHash.Hash[0] ^= 1;
+    TestFalse(TEXT("Snapshot of different inputs is rejected"), FSuzieDumpSnapshot::Load(SnapshotFilePath, OtherInputHash, LoadedRootObject, LoadedSkippedObjectPaths));
+    const bool bLoaded = FSuzieDumpSnapshot::Load(SnapshotFilePath, InputHash, LoadedRootObject, LoadedSkippedObjectPaths);
+    IFileManager::Get().Delete(*SnapshotFilePath);
+    if (!TestTrue(TEXT("Snapshot is loaded"), bLoaded))
+    {
+        return false;
+    }
+    TestTrue(TEXT("Loaded dump is identical to the parsed dump"), AreJsonValuesIdentical(MakeShared<FJsonValueObject>(ParsedRootObject), MakeShared<FJsonValueObject>(LoadedRootObject)));
+    TestTrue(TEXT("Skipped object paths are restored"), LoadedSkippedObjectPaths.Num() == SkippedObjectPaths.Num() && LoadedSkippedObjectPaths.Includes(SkippedObjectPaths));
+    return true;
+}
+
+#endif
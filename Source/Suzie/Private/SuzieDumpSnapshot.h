@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+class FArchive;
+class FJsonObject;
+class FJsonValue;
+
+// Binary snapshot of the merged dumps that generation runs on, or of a single parsed base dump. Reading it is much faster than decompressing, parsing,
+// merging and pruning the dumps, and it is only used when the hash of the inputs it has been created from matches
+class FSuzieDumpSnapshot
+{
+public:
+    /** Writes the merged root object and the paths of the objects skipped while parsing the dumps to the file */
+    static bool Save(const FString& FilePath, const FSHAHash& InputHash, const TSharedPtr<FJsonObject>& RootObject, const TSet<FString>& SkippedObjectPaths);
+    /** Reads the snapshot from the file. Fails without reading the rest of the file if the snapshot has been created from different inputs */
+    static bool Load(const FString& FilePath, const FSHAHash& InputHash, TSharedPtr<FJsonObject>& OutRootObject, TSet<FString>& OutSkippedObjectPaths);
+private:
+    // FString keys hash and compare case-insensitively by default, which would merge strings that only differ in case into one entry
+    struct FCaseSensitiveStringKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+    {
+        static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+    };
+    using FStringIndexMap = TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs>;
+
+    static void GatherStrings(const TSharedPtr<FJsonValue>& Value, FStringIndexMap& StringIndices);
+    static void WriteValue(FArchive& Ar, const TSharedPtr<FJsonValue>& Value, const FStringIndexMap& StringIndices);
+    static TSharedPtr<FJsonValue> ReadValue(FArchive& Ar, const TArray<FString>& Strings);
+};
@@ -0,0 +1,542 @@
+#include "SuzieDumpValidator.h"
+#include "SuziePlugin.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Paths.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+#include "UObject/PropertyOptional.h"
+#endif
+
+// Reference to an object that is not in the dumps. These are looked up in the editor once all objects have been checked
+struct FSuzieUnresolvedReference
+{
+    FString ObjectPath;
+    FString ReferencedObjectPath;
+    const TCHAR* ExpectedType;
+    FString Description;
+};
+
+struct FSuzieDumpValidator::FTaskContext
+{
+    TArray<FSuzieDumpValidationIssue> Issues;
+    TArray<FSuzieUnresolvedReference> UnresolvedReferences;
+    // Types that have to be created before the type that depends on them: super structs and structs contained by value
+    TArray<TPair<FString, FString>> Dependencies;
+
+    void AddIssue(const bool bIsError, const FString& ObjectPath, FString&& Message)
+    {
+        Issues.Add({bIsError, ObjectPath, MoveTemp(Message)});
+    }
+};
+
+// Fields every object of the type needs to have to be generated, see FSuziePluginModule::FindOrCreateClass and friends
+static const TArray<TPair<FString, TArray<const TCHAR*>>>& GetRequiredObjectFields()
+{
+    static const TArray<TPair<FString, TArray<const TCHAR*>>> RequiredObjectFields = {
+        {TEXT("Class"), {TEXT("super_struct"), TEXT("class_flags"), TEXT("class_default_object"), TEXT("children"), TEXT("properties")}},
+        {TEXT("ScriptStruct"), {TEXT("struct_flags"), TEXT("properties")}},
+        {TEXT("Enum"), {TEXT("cpp_type"), TEXT("names")}},
+        {TEXT("Function"), {TEXT("function_flags"), TEXT("properties")}},
+        {TEXT("Object"), {TEXT("class"), TEXT("object_flags")}},
+    };
+    return RequiredObjectFields;
+}
+
+static UClass* GetNativeTypeClass(const TCHAR* ExpectedType)
+{
+    const FStringView TypeName = ExpectedType;
+    if (TypeName == TEXT("Class"))
+    {
+        return UClass::StaticClass();
+    }
+    if (TypeName == TEXT("ScriptStruct"))
+    {
+        return UScriptStruct::StaticClass();
+    }
+    if (TypeName == TEXT("Enum"))
+    {
+        return UEnum::StaticClass();
+    }
+    if (TypeName == TEXT("Function"))
+    {
+        return UFunction::StaticClass();
+    }
+    return UObject::StaticClass();
+}
+
+void FSuzieDumpValidator::AddDump(const FString& DumpFileName, TMap<FString, TSharedPtr<FJsonValue>>&& ObjectMap)
+{
+    ObjectsByPath.Reserve(ObjectsByPath.Num() + ObjectMap.Num());
+    for (auto& [ObjectPath, ObjectValue] : ObjectMap)
+    {
+        const TSharedPtr<FJsonObject> ObjectDefinition = ObjectValue.IsValid() ? ObjectValue->AsObject() : nullptr;
+        if (!ObjectDefinition.IsValid())
+        {
+            Issues.Add({true, ObjectPath, FString::Printf(TEXT("Definition in %s is not an object"), *DumpFileName)});
+            continue;
+        }
+        if (const TSharedPtr<FJsonObject>* ExistingObjectDefinition = ObjectsByPath.Find(ObjectPath))
+        {
+            // Identical duplicates are expected, e.g. in base game and DLC dumps
+            if (!FJsonValue::CompareEqual(FJsonValueObject(*ExistingObjectDefinition), FJsonValueObject(ObjectDefinition)))
+            {
+                Issues.Add({false, ObjectPath, FString::Printf(TEXT("Definition in %s conflicts with the earlier one in %s, which is used"),
+                    *DumpFileName, *DumpFileNamesByObjectPath.FindChecked(ObjectPath))});
+            }
+            continue;
+        }
+        ObjectsByPath.Add(ObjectPath, ObjectDefinition);
+        DumpFileNamesByObjectPath.Add(ObjectPath, DumpFileName);
+    }
+}
+
+int32 FSuzieDumpValidator::GetNumErrors() const
+{
+    int32 NumErrors = 0;
+    for (const FSuzieDumpValidationIssue& Issue : Issues)
+    {
+        NumErrors += Issue.bIsError ? 1 : 0;
+    }
+    return NumErrors;
+}
+
+void FSuzieDumpValidator::Validate(const TSet<FString>& SkippedObjectPaths)
+{
+    // Objects only read the definitions of other objects, so they can be checked independently of each other
+    TArray<FString> ObjectPaths;
+    ObjectsByPath.GenerateKeyArray(ObjectPaths);
+    TArray<FTaskContext> TaskContexts;
+    ParallelForWithTaskContext(TaskContexts, ObjectPaths.Num(), [&](FTaskContext& TaskContext, const int32 ObjectIndex)
+    {
+        ValidateObject(TaskContext, ObjectPaths[ObjectIndex], ObjectsByPath.FindChecked(ObjectPaths[ObjectIndex]));
+    });
+
+    TArray<TPair<FString, FString>> Dependencies;
+    TMap<FString, TArray<const FSuzieUnresolvedReference*>> UnresolvedReferencesByPath;
+    for (FTaskContext& TaskContext : TaskContexts)
+    {
+        Issues.Append(MoveTemp(TaskContext.Issues));
+        Dependencies.Append(MoveTemp(TaskContext.Dependencies));
+        for (const FSuzieUnresolvedReference& UnresolvedReference : TaskContext.UnresolvedReferences)
+        {
+            UnresolvedReferencesByPath.FindOrAdd(UnresolvedReference.ReferencedObjectPath).Add(&UnresolvedReference);
+        }
+    }
+
+    // Objects that are not in the dumps have to be native. Finding objects is done on the game thread, once per referenced object
+    for (const auto& [ReferencedObjectPath, UnresolvedReferences] : UnresolvedReferencesByPath)
+    {
+        const UObject* NativeObject = FindObject<UObject>(nullptr, *ReferencedObjectPath);
+        for (const FSuzieUnresolvedReference* UnresolvedReference : UnresolvedReferences)
+        {
+            if (NativeObject == nullptr)
+            {
+                // Generation falls back to a placeholder type for skipped objects, and crashes for all other ones
+                const bool bIsSkipped = SkippedObjectPaths.Contains(ReferencedObjectPath);
+                Issues.Add({!bIsSkipped, UnresolvedReference->ObjectPath, FString::Printf(TEXT("%s %s is not in the dumps%s"), *UnresolvedReference->Description, *ReferencedObjectPath,
+                    bIsSkipped ? TEXT(" because its package is skipped, and does not exist in the editor") : TEXT(" or the editor"))});
+            }
+            else if (!NativeObject->IsA(GetNativeTypeClass(UnresolvedReference->ExpectedType)))
+            {
+                Issues.Add({true, UnresolvedReference->ObjectPath, FString::Printf(TEXT("%s %s is a %s, expected %s"), *UnresolvedReference->Description, *ReferencedObjectPath,
+                    *NativeObject->GetClass()->GetName(), UnresolvedReference->ExpectedType)});
+            }
+        }
+    }
+
+    FindTypeHierarchyCycles(Dependencies);
+
+    // Sorted so that the output can be diffed between runs
+    Issues.StableSort([](const FSuzieDumpValidationIssue& A, const FSuzieDumpValidationIssue& B)
+    {
+        return A.bIsError != B.bIsError ? A.bIsError : A.ObjectPath < B.ObjectPath;
+    });
+}
+
+void FSuzieDumpValidator::ValidateObject(FTaskContext& TaskContext, const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition) const
+{
+    FString ObjectType;
+    if (!ObjectDefinition->TryGetStringField(TEXT("type"), ObjectType))
+    {
+        TaskContext.AddIssue(true, ObjectPath, TEXT("Object has no type"));
+        return;
+    }
+    const TPair<FString, TArray<const TCHAR*>>* RequiredFields = GetRequiredObjectFields().FindByPredicate([&](const TPair<FString, TArray<const TCHAR*>>& Entry) { return Entry.Key == ObjectType; });
+    if (RequiredFields == nullptr)
+    {
+        // Other objects are not generated, so there is nothing else to check about them
+        return;
+    }
+    // Meatloaf bug (commit d8179e8): default objects of UClass-derived native classes are labeled as classes. Generation skips them
+    if (ObjectType == TEXT("Class") && ObjectPath.Contains(TEXT(".Default__")))
+    {
+        return;
+    }
+    bool bHasRequiredFields = true;
+    for (const TCHAR* RequiredField : RequiredFields->Value)
+    {
+        if (!ObjectDefinition->HasField(RequiredField))
+        {
+            TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("%s has no %s field"), *ObjectType, RequiredField));
+            bHasRequiredFields = false;
+        }
+    }
+    if (!bHasRequiredFields)
+    {
+        return;
+    }
+
+    FString SuperStructPath;
+    if (ObjectDefinition->TryGetStringField(TEXT("super_struct"), SuperStructPath) && !SuperStructPath.IsEmpty())
+    {
+        ValidateReference(TaskContext, ObjectPath, SuperStructPath, *ObjectType, TEXT("Super struct"));
+        TaskContext.Dependencies.Add({ObjectPath, SuperStructPath});
+    }
+    else if (ObjectType == TEXT("Class"))
+    {
+        TaskContext.AddIssue(false, ObjectPath, TEXT("Class has no super struct, Class is used as its parent"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Properties;
+    if (ObjectDefinition->TryGetArrayField(TEXT("properties"), Properties))
+    {
+        for (const TSharedPtr<FJsonValue>& PropertyValue : *Properties)
+        {
+            const TSharedPtr<FJsonObject> PropertyDescriptor = PropertyValue->AsObject();
+            if (!PropertyDescriptor.IsValid())
+            {
+                TaskContext.AddIssue(true, ObjectPath, TEXT("Property is not an object"));
+                continue;
+            }
+            ValidateProperty(TaskContext, ObjectPath, PropertyDescriptor);
+
+            // Structs contained by value need to be complete before the size of the containing type is known
+            FString PropertyType, StructPath;
+            if (PropertyDescriptor->TryGetStringField(TEXT("type"), PropertyType) && PropertyType == TEXT("StructProperty") && PropertyDescriptor->TryGetStringField(TEXT("struct"), StructPath))
+            {
+                TaskContext.Dependencies.Add({ObjectPath, StructPath});
+            }
+        }
+    }
+
+    FString ReferencedObjectPath;
+    if (ObjectType == TEXT("Class"))
+    {
+        ObjectDefinition->TryGetStringField(TEXT("class_default_object"), ReferencedObjectPath);
+        ValidateReference(TaskContext, ObjectPath, ReferencedObjectPath, TEXT("Object"), TEXT("Default object"));
+    }
+    else if (ObjectType == TEXT("Object"))
+    {
+        ObjectDefinition->TryGetStringField(TEXT("class"), ReferencedObjectPath);
+        ValidateReference(TaskContext, ObjectPath, ReferencedObjectPath, TEXT("Class"), TEXT("Class"));
+    }
+
+    // Children are functions of classes and subobjects of objects. Both are found by their path, so they have to be nested in their outer
+    const TArray<TSharedPtr<FJsonValue>>* Children;
+    if (ObjectDefinition->TryGetArrayField(TEXT("children"), Children))
+    {
+        for (const TSharedPtr<FJsonValue>& ChildValue : *Children)
+        {
+            const FString ChildPath = ChildValue->AsString();
+            const FString ChildName = ChildPath.RightChop(ObjectPath.Len() + 1);
+            int32 UnusedCharacterIndex;
+            if (!ChildPath.StartsWith(ObjectPath) || ChildPath.Len() <= ObjectPath.Len() + 1 || ChildPath[ObjectPath.Len()] != ':' ||
+                ChildName.FindChar(':', UnusedCharacterIndex) || ChildName.FindChar('.', UnusedCharacterIndex))
+            {
+                TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("Child %s is not nested in its outer"), *ChildPath));
+                continue;
+            }
+            const TSharedPtr<FJsonObject>* ChildDefinition = ObjectsByPath.Find(ChildPath);
+            if (ChildDefinition == nullptr)
+            {
+                TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("Child %s is not in the dumps"), *ChildPath));
+                continue;
+            }
+            const TCHAR* ExpectedChildType = ObjectType == TEXT("Class") ? TEXT("Function") : TEXT("Object");
+            FString ChildType;
+            (*ChildDefinition)->TryGetStringField(TEXT("type"), ChildType);
+            if (ObjectType != TEXT("Function") && ChildType != ExpectedChildType)
+            {
+                TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("Child %s is a %s, expected %s"), *ChildPath, *ChildType, ExpectedChildType));
+            }
+        }
+    }
+}
+
+void FSuzieDumpValidator::ValidateProperty(FTaskContext& TaskContext, const FString& ObjectPath, const TSharedPtr<FJsonObject>& PropertyDescriptor) const
+{
+    FString PropertyName, PropertyType;
+    if (!PropertyDescriptor->TryGetStringField(TEXT("name"), PropertyName) || !PropertyDescriptor->TryGetStringField(TEXT("type"), PropertyType) || !PropertyDescriptor->HasField(TEXT("flags")))
+    {
+        TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("Property %s has no name, type or flags"), *PropertyName));
+        return;
+    }
+
+    // Same lookup as FField::Construct, properties of unknown types are left out by generation
+    FFieldClass* const* PropertyClassPtr = FFieldClass::GetNameToFieldClassMap().Find(FName(*PropertyType));
+    const FFieldClass* PropertyClass = PropertyClassPtr ? *PropertyClassPtr : nullptr;
+    if (PropertyClass == nullptr || !PropertyClass->IsChildOf(FProperty::StaticClass()))
+    {
+        TaskContext.AddIssue(false, ObjectPath, FString::Printf(TEXT("Property %s has unsupported type %s and is left out"), *PropertyName, *PropertyType));
+        return;
+    }
+
+    auto ValidateTypeReference = [&](const TCHAR* FieldName, const TCHAR* ExpectedType)
+    {
+        FString ReferencedObjectPath;
+        if (!PropertyDescriptor->TryGetStringField(FieldName, ReferencedObjectPath) || ReferencedObjectPath.IsEmpty())
+        {
+            TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("%s %s has no %s"), *PropertyType, *PropertyName, FieldName));
+            return;
+        }
+        ValidateReference(TaskContext, ObjectPath, ReferencedObjectPath, ExpectedType, *FString::Printf(TEXT("Type %s of property %s"), FieldName, *PropertyName));
+    };
+    auto ValidateInnerProperty = [&](const TCHAR* FieldName)
+    {
+        const TSharedPtr<FJsonObject>* InnerPropertyDescriptor;
+        if (!PropertyDescriptor->TryGetObjectField(FieldName, InnerPropertyDescriptor))
+        {
+            TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("%s %s has no %s"), *PropertyType, *PropertyName, FieldName));
+            return;
+        }
+        ValidateProperty(TaskContext, ObjectPath, *InnerPropertyDescriptor);
+    };
+
+    // Mirrors the fields FSuziePluginModule::BuildProperty reads for each property type
+    if (PropertyClass->IsChildOf(FObjectPropertyBase::StaticClass()))
+    {
+        ValidateTypeReference(TEXT("property_class"), TEXT("Class"));
+        if (PropertyClass->IsChildOf(FClassProperty::StaticClass()) || PropertyClass->IsChildOf(FSoftClassProperty::StaticClass()))
+        {
+            ValidateTypeReference(TEXT("meta_class"), TEXT("Class"));
+        }
+    }
+    else if (PropertyClass->IsChildOf(FInterfaceProperty::StaticClass()))
+    {
+        ValidateTypeReference(TEXT("interface_class"), TEXT("Class"));
+    }
+    else if (PropertyClass->IsChildOf(FStructProperty::StaticClass()))
+    {
+        ValidateTypeReference(TEXT("struct"), TEXT("ScriptStruct"));
+    }
+    else if (PropertyClass->IsChildOf(FEnumProperty::StaticClass()))
+    {
+        ValidateTypeReference(TEXT("enum"), TEXT("Enum"));
+        ValidateInnerProperty(TEXT("container"));
+    }
+    else if (PropertyClass->IsChildOf(FByteProperty::StaticClass()))
+    {
+        FString EnumPath;
+        if (PropertyDescriptor->TryGetStringField(TEXT("enum"), EnumPath) && !EnumPath.IsEmpty())
+        {
+            ValidateReference(TaskContext, ObjectPath, EnumPath, TEXT("Enum"), *FString::Printf(TEXT("Type enum of property %s"), *PropertyName));
+        }
+    }
+    else if (PropertyClass->IsChildOf(FDelegateProperty::StaticClass()) || PropertyClass->IsChildOf(FMulticastDelegateProperty::StaticClass()))
+    {
+        ValidateTypeReference(TEXT("signature_function"), TEXT("Function"));
+    }
+    else if (PropertyClass->IsChildOf(FArrayProperty::StaticClass()))
+    {
+        ValidateInnerProperty(TEXT("inner"));
+    }
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+    else if (PropertyClass->IsChildOf(FOptionalProperty::StaticClass()))
+    {
+        ValidateInnerProperty(TEXT("inner"));
+    }
+#endif
+    else if (PropertyClass->IsChildOf(FSetProperty::StaticClass()))
+    {
+        ValidateInnerProperty(TEXT("key_prop"));
+    }
+    else if (PropertyClass->IsChildOf(FMapProperty::StaticClass()))
+    {
+        ValidateInnerProperty(TEXT("key_prop"));
+        ValidateInnerProperty(TEXT("value_prop"));
+    }
+}
+
+void FSuzieDumpValidator::ValidateReference(FTaskContext& TaskContext, const FString& ObjectPath, const FString& ReferencedObjectPath, const TCHAR* ExpectedType, const TCHAR* Description) const
+{
+    if (ReferencedObjectPath.IsEmpty())
+    {
+        TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("%s is empty"), Description));
+        return;
+    }
+    const TSharedPtr<FJsonObject>* ReferencedObjectDefinition = ObjectsByPath.Find(ReferencedObjectPath);
+    if (ReferencedObjectDefinition == nullptr)
+    {
+        TaskContext.UnresolvedReferences.Add({ObjectPath, ReferencedObjectPath, ExpectedType, Description});
+        return;
+    }
+    FString ReferencedObjectType;
+    (*ReferencedObjectDefinition)->TryGetStringField(TEXT("type"), ReferencedObjectType);
+    if (ReferencedObjectType != ExpectedType)
+    {
+        TaskContext.AddIssue(true, ObjectPath, FString::Printf(TEXT("%s %s is a %s, expected %s"), Description, *ReferencedObjectPath, *ReferencedObjectType, ExpectedType));
+    }
+}
+
+void FSuzieDumpValidator::FindTypeHierarchyCycles(const TArray<TPair<FString, FString>>& Dependencies)
+{
+    TMap<FString, TArray<FString>> DependenciesByPath;
+    for (const auto& [ObjectPath, DependencyPath] : Dependencies)
+    {
+        // Native types cannot depend on the types in the dumps
+        if (ObjectsByPath.Contains(DependencyPath))
+        {
+            DependenciesByPath.FindOrAdd(ObjectPath).Add(DependencyPath);
+        }
+    }
+
+    // Depth first search, iterative since the hierarchies of real dumps are deep. Types on the current path are in progress, a dependency on one of them is a cycle
+    enum class EVisitState : uint8 { InProgress, Done };
+    TMap<FString, EVisitState> VisitStates;
+    TArray<FString> SortedPaths;
+    DependenciesByPath.GenerateKeyArray(SortedPaths);
+    SortedPaths.Sort();
+    for (const FString& RootPath : SortedPaths)
+    {
+        if (VisitStates.Contains(RootPath))
+        {
+            continue;
+        }
+        TArray<TPair<FString, int32>> Stack;
+        Stack.Add({RootPath, 0});
+        VisitStates.Add(RootPath, EVisitState::InProgress);
+        while (!Stack.IsEmpty())
+        {
+            const TArray<FString>* NodeDependencies = DependenciesByPath.Find(Stack.Last().Key);
+            if (NodeDependencies == nullptr || Stack.Last().Value >= NodeDependencies->Num())
+            {
+                VisitStates.Add(Stack.Pop().Key, EVisitState::Done);
+                continue;
+            }
+            const FString& DependencyPath = (*NodeDependencies)[Stack.Last().Value++];
+            const EVisitState* DependencyState = VisitStates.Find(DependencyPath);
+            if (DependencyState == nullptr)
+            {
+                VisitStates.Add(DependencyPath, EVisitState::InProgress);
+                Stack.Add({DependencyPath, 0});
+            }
+            else if (*DependencyState == EVisitState::InProgress)
+            {
+                FString Cycle;
+                for (int32 StackIndex = Stack.IndexOfByPredicate([&](const TPair<FString, int32>& Entry) { return Entry.Key == DependencyPath; }); StackIndex < Stack.Num(); StackIndex++)
+                {
+                    Cycle += Stack[StackIndex].Key + TEXT(" -> ");
+                }
+                Issues.Add({true, DependencyPath, FString::Printf(TEXT("Type depends on itself through super structs or structs contained by value: %s%s"), *Cycle, *DependencyPath)});
+            }
+        }
+    }
+}
+
+bool FSuziePluginModule::ValidateJsonClassDefinitions(const FString& DumpDirectory, const int32 NumLoggedIssues, const bool bWarningsAsErrors)
+{
+    TGuardValue<FString> DumpDirectoryGuard(BenchmarkDumpDirectory, DumpDirectory.IsEmpty() ? BenchmarkDumpDirectory : FPaths::ConvertRelativePathToFull(DumpDirectory));
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Same files and skipped packages as generation would use
+    GatherSkippedPackageNames();
+    TArray<FString> DumpFileNames;
+    TArray<FString> OverlayFileNames;
+    FindJsonClassDefinitionFiles(DumpFileNames, OverlayFileNames);
+    TMap<FString, TArray<TSharedPtr<FJsonObject>>> OverlaysByDumpName;
+    LoadJsonClassDefinitionOverlays(OverlayFileNames, OverlaysByDumpName);
+
+    // Every shard of a sharded dump is validated, since any of them can be loaded on demand
+    TArray<FString> FilePaths;
+    TArray<int32> FileDumpIndices;
+    DumpShardFilePathByPackageName.Reset();
+    DumpShardPackageDependencies.Reset();
+    DumpShardDumpNames.Reset();
+    for (int32 DumpIndex = 0; DumpIndex < DumpFileNames.Num(); DumpIndex++)
+    {
+        TArray<FString> DumpFilePaths;
+        if (!IsJsonClassDefinitionShardIndexFile(DumpFileNames[DumpIndex]))
+        {
+            DumpFilePaths.Add(JsonClassesPath / DumpFileNames[DumpIndex]);
+        }
+        else if (!LoadJsonClassDefinitionShardIndex(JsonClassesPath / DumpFileNames[DumpIndex], GetJsonClassDefinitionDumpName(DumpFileNames[DumpIndex]), DumpFilePaths))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to load shard index %s"), *DumpFileNames[DumpIndex]);
+        }
+        for (const FString& DumpFilePath : DumpFilePaths)
+        {
+            FilePaths.Add(DumpFilePath);
+            FileDumpIndices.Add(DumpIndex);
+        }
+    }
+
+    // Files are independent, so they are read, decompressed and parsed on all cores
+    TArray<TSharedPtr<FJsonObject>> FileRootObjects;
+    TArray<TSet<FString>> FileSkippedObjectPaths;
+    FileRootObjects.SetNum(FilePaths.Num());
+    FileSkippedObjectPaths.SetNum(FilePaths.Num());
+    ParallelFor(FilePaths.Num(), [&](const int32 FileIndex)
+    {
+        if (!LoadJsonClassDefinitionFile(FilePaths[FileIndex], FileRootObjects[FileIndex], &SkippedPackageNames, &FileSkippedObjectPaths[FileIndex]))
+        {
+            FileRootObjects[FileIndex].Reset();
+        }
+    });
+    const double LoadEndTime = FPlatformTime::Seconds();
+
+    // Dumps are added in the order of their file names, with their overlays applied, the same way they are merged for generation
+    FSuzieDumpValidator Validator;
+    TSet<FString> AllSkippedObjectPaths;
+    int32 NumFailedFiles = 0;
+    for (int32 FileIndex = 0; FileIndex < FilePaths.Num(); FileIndex++)
+    {
+        AllSkippedObjectPaths.Append(MoveTemp(FileSkippedObjectPaths[FileIndex]));
+        const TSharedPtr<FJsonObject>* Objects;
+        if (!FileRootObjects[FileIndex].IsValid() || !FileRootObjects[FileIndex]->TryGetObjectField(TEXT("objects"), Objects))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to load %s, or it has no 'objects' map"), *FilePaths[FileIndex]);
+            NumFailedFiles++;
+            continue;
+        }
+        // Objects the overlays add to a sharded dump are added with its first shard, the other shards only take the objects they contain
+        const FString& DumpFileName = DumpFileNames[FileDumpIndices[FileIndex]];
+        const bool bIsFirstFileOfDump = FileIndex == 0 || FileDumpIndices[FileIndex - 1] != FileDumpIndices[FileIndex];
+        if (const TArray<TSharedPtr<FJsonObject>>* Overlays = OverlaysByDumpName.Find(GetJsonClassDefinitionDumpName(DumpFileName)))
+        {
+            for (const TSharedPtr<FJsonObject>& Overlay : *Overlays)
+            {
+                ApplyJsonClassDefinitionOverlay(FileRootObjects[FileIndex], Overlay, bIsFirstFileOfDump);
+            }
+        }
+        Validator.AddDump(FPaths::GetCleanFilename(FilePaths[FileIndex]), MoveTemp((*Objects)->Values));
+        FileRootObjects[FileIndex].Reset();
+    }
+    Validator.Validate(AllSkippedObjectPaths);
+
+    const TArray<FSuzieDumpValidationIssue>& Issues = Validator.GetIssues();
+    for (int32 IssueIndex = 0; IssueIndex < FMath::Min(NumLoggedIssues, Issues.Num()); IssueIndex++)
+    {
+        const FSuzieDumpValidationIssue& Issue = Issues[IssueIndex];
+        if (Issue.bIsError)
+        {
+            UE_LOG(LogSuzie, Error, TEXT("%s: %s"), *Issue.ObjectPath, *Issue.Message);
+        }
+        else
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("%s: %s"), *Issue.ObjectPath, *Issue.Message);
+        }
+    }
+    if (Issues.Num() > NumLoggedIssues)
+    {
+        UE_LOG(LogSuzie, Display, TEXT("%d more issues have not been logged"), Issues.Num() - NumLoggedIssues);
+    }
+
+    const int32 NumErrors = Validator.GetNumErrors() + NumFailedFiles;
+    const int32 NumWarnings = Issues.Num() - Validator.GetNumErrors();
+    UE_LOG(LogSuzie, Display, TEXT("Validated %d objects from %d files in %.2f seconds (%.2f loading): %d errors, %d warnings"),
+        Validator.GetNumObjects(), FilePaths.Num(), FPlatformTime::Seconds() - StartTime, LoadEndTime - StartTime, NumErrors, NumWarnings);
+    return NumErrors == 0 && (!bWarningsAsErrors || NumWarnings == 0);
+}
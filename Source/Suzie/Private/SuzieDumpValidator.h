@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+
+// Problem in the dumps that would make generation crash (errors) or fall back to a placeholder type (warnings)
+struct FSuzieDumpValidationIssue
+{
+    bool bIsError{};
+    FString ObjectPath;
+    FString Message;
+};
+
+// Checks that types can be generated from the dumps without generating anything, so that broken dumps are found without starting the editor
+class FSuzieDumpValidator
+{
+public:
+    /** Adds the objects of a dump. Objects defined differently by an earlier dump are reported, and the earlier definition is kept the same way generation keeps it */
+    void AddDump(const FString& DumpFileName, TMap<FString, TSharedPtr<FJsonValue>>&& ObjectMap);
+
+    /**
+     * Checks every object in parallel: required fields, property types, references to other objects, nesting of children and cycles in the type hierarchy.
+     * References to objects that are not in the dumps are looked up in the editor. References to skipped objects that do not exist are only warnings, since generation falls back to a placeholder type for them
+     */
+    void Validate(const TSet<FString>& SkippedObjectPaths);
+
+    int32 GetNumObjects() const { return ObjectsByPath.Num(); }
+    int32 GetNumErrors() const;
+    const TArray<FSuzieDumpValidationIssue>& GetIssues() const { return Issues; }
+private:
+    struct FTaskContext;
+
+    void ValidateObject(FTaskContext& TaskContext, const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition) const;
+    void ValidateProperty(FTaskContext& TaskContext, const FString& ObjectPath, const TSharedPtr<FJsonObject>& PropertyDescriptor) const;
+    void ValidateReference(FTaskContext& TaskContext, const FString& ObjectPath, const FString& ReferencedObjectPath, const TCHAR* ExpectedType, const TCHAR* Description) const;
+    void FindTypeHierarchyCycles(const TArray<TPair<FString, FString>>& Dependencies);
+
+    TMap<FString, TSharedPtr<FJsonObject>> ObjectsByPath;
+    TMap<FString, FString> DumpFileNamesByObjectPath;
+    TArray<FSuzieDumpValidationIssue> Issues;
+};
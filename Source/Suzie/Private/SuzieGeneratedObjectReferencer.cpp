@@ -0,0 +1,97 @@
+#include "SuzieGeneratedObjectReferencer.h"
+#include "SuziePlugin.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+void FSuzieGeneratedObjectReferencer::AddObject(UObject* Object)
+{
+    Objects.Add(Object);
+}
+
+void FSuzieGeneratedObjectReferencer::RemoveObject(UObject* Object)
+{
+    Objects.RemoveSingleSwap(Object);
+}
+
+void FSuzieGeneratedObjectReferencer::AddField(FField* Field)
+{
+    Fields.Add(Field);
+}
+
+void FSuzieGeneratedObjectReferencer::RemoveField(FField* Field)
+{
+    Fields.RemoveSingleSwap(Field);
+}
+
+void FSuzieGeneratedObjectReferencer::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    // Array is never modified while garbage collection is running, so it can be collected without copying it
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+    Collector.AddStableReferenceArray(&Objects);
+#else
+    Collector.AddReferencedObjects(Objects);
+#endif
+    for (FField* Field : Fields)
+    {
+        Field->AddReferencedObjects(Collector);
+    }
+}
+
+FString FSuzieGeneratedObjectReferencer::GetReferencerName() const
+{
+    return TEXT("FSuzieGeneratedObjectReferencer");
+}
+
+void FSuziePluginModule::CompareGarbageCollectionTiming(const int32 NumCollections)
+{
+    const TArray<TObjectPtr<UObject>> GeneratedObjects = GetGeneratedObjects();
+
+    auto MeasureAverageCollectionTime = [NumCollections]()
+    {
+        double TotalTime = 0.0;
+        for (int32 CollectionIndex = 0; CollectionIndex < NumCollections; CollectionIndex++)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+            TotalTime += FPlatformTime::Seconds() - StartTime;
+        }
+        return TotalTime / NumCollections;
+    };
+
+    // First collection gets rid of any garbage accumulated until now, so both measurements only do the reachability analysis
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+    const double ReferencerCollectionTime = MeasureAverageCollectionTime();
+
+    // Objects are only kept alive by the root set while it is measured, and are handed back to the referencer afterwards.
+    // Objects that were already in the root set (e.g. added there by other systems) must stay there
+    TArray<TObjectPtr<UObject>> ReferencedObjects = GeneratedObjectReferencer.IsValid() ? GeneratedObjectReferencer->TakeObjects() : TArray<TObjectPtr<UObject>>();
+    TArray<UObject*> TemporarilyRootedObjects;
+    for (UObject* GeneratedObject : GeneratedObjects)
+    {
+        if (GeneratedObject && !GeneratedObject->IsRooted())
+        {
+            GeneratedObject->AddToRoot();
+            TemporarilyRootedObjects.Add(GeneratedObject);
+        }
+    }
+    const double RootSetCollectionTime = MeasureAverageCollectionTime();
+    if (GeneratedObjectReferencer.IsValid())
+    {
+        GeneratedObjectReferencer->AddObjects(ReferencedObjects);
+    }
+    for (UObject* RootedObject : TemporarilyRootedObjects)
+    {
+        RootedObject->RemoveFromRoot();
+    }
+
+    UE_LOG(LogSuzie, Display, TEXT("Garbage collection with %d generated objects, average of %d collections: %.2f ms with a single referencer, %.2f ms with root set objects"),
+        GeneratedObjects.Num(), NumCollections, ReferencerCollectionTime * 1000.0, RootSetCollectionTime * 1000.0);
+}
+
+static FAutoConsoleCommand CompareGarbageCollectionTimingCommand(
+    TEXT("Suzie.CompareGCTiming"),
+    TEXT("Measures full garbage collection time with generated objects kept alive by a single referencer and with each of them added to the root set. Optional argument is the number of collections to average over"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuziePluginModule::CompareGarbageCollectionTiming(Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5);
+    }));
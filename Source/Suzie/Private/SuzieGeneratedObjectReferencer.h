@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class FSuzieGeneratedObjectReferencer : public FGCObject
+{
+public:
+    /** Keeps the object alive until it is removed. Used instead of adding each generated type to the root set individually */
+    void AddObject(UObject* Object);
+    /** Allows the object to be garbage collected once nothing else references it */
+    void RemoveObject(UObject* Object);
+    /** Returns all objects currently kept alive */
+    const TArray<TObjectPtr<UObject>>& GetObjects() const { return Objects; }
+    /** Stops keeping all objects alive and returns them, so that they can be added back later */
+    TArray<TObjectPtr<UObject>> TakeObjects() { return MoveTemp(Objects); }
+    void AddObjects(const TArray<TObjectPtr<UObject>>& InObjects) { Objects.Append(InObjects); }
+    /** Reports the objects the field references, e.g. the class of an object property, for as long as the field is kept */
+    void AddField(FField* Field);
+    void RemoveField(FField* Field);
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override;
+private:
+    TArray<TObjectPtr<UObject>> Objects;
+    // Fields that are not owned by a struct, so nothing else reports their references
+    TArray<FField*> Fields;
+};
@@ -0,0 +1,223 @@
+#include "SuzieGenerationProfile.h"
+#include "SuziePlugin.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// Phases shorter than this are too noisy to be compared against the previous run
+static constexpr double MinRegressionSeconds = 0.25;
+
+// Returns the seconds of every phase of a profile written by Save
+static TMap<FString, double> GetProfilePhaseSeconds(const TSharedPtr<FJsonObject>& Profile)
+{
+    TMap<FString, double> PhaseSeconds;
+    const TArray<TSharedPtr<FJsonValue>>* Phases;
+    if (Profile.IsValid() && Profile->TryGetArrayField(TEXT("phases"), Phases))
+    {
+        for (const TSharedPtr<FJsonValue>& Phase : *Phases)
+        {
+            const TSharedPtr<FJsonObject> PhaseObject = Phase->AsObject();
+            if (PhaseObject.IsValid())
+            {
+                PhaseSeconds.Add(PhaseObject->GetStringField(TEXT("name")), PhaseObject->GetNumberField(TEXT("seconds")));
+            }
+        }
+    }
+    return PhaseSeconds;
+}
+
+FSuzieGenerationProfile::FScopedPhase::FScopedPhase(FSuzieGenerationProfile* InProfile, const TCHAR* PhaseName) : Profile(InProfile), Name(PhaseName), StartTime(FPlatformTime::Seconds())
+{
+}
+
+FSuzieGenerationProfile::FScopedPhase::~FScopedPhase()
+{
+    if (Profile)
+    {
+        Profile->Phases.Add({Name, FPlatformTime::Seconds() - StartTime, FPlatformMemory::GetStats().UsedPhysical});
+    }
+}
+
+FSuzieGenerationProfile::FScopedFile::FScopedFile(FSuzieGenerationProfile* InProfile, const FString& InFilePath) : Profile(InProfile), FilePath(InFilePath), StartTime(FPlatformTime::Seconds())
+{
+}
+
+FSuzieGenerationProfile::FScopedFile::~FScopedFile()
+{
+    if (Profile)
+    {
+        Profile->Files.Add({FPaths::GetCleanFilename(FilePath), FPlatformTime::Seconds() - StartTime, IFileManager::Get().FileSize(*FilePath)});
+    }
+}
+
+FSuzieGenerationProfile::FScopedType::FScopedType(FSuzieGenerationProfile* InProfile, const FString& TypePath) : Profile(InProfile)
+{
+    if (Profile)
+    {
+        Profile->TypeStack.Add({TypePath, FPlatformTime::Seconds()});
+    }
+}
+
+FSuzieGenerationProfile::FScopedType::~FScopedType()
+{
+    if (Profile)
+    {
+        // Types are created recursively, so the time of the nested types is subtracted from the time of the type that caused them to be created
+        const FTypeStackEntry Entry = Profile->TypeStack.Pop();
+        const double ElapsedSeconds = FPlatformTime::Seconds() - Entry.StartTime;
+        Profile->TypeSeconds.FindOrAdd(Entry.TypePath) += ElapsedSeconds - Entry.NestedSeconds;
+        if (!Profile->TypeStack.IsEmpty())
+        {
+            Profile->TypeStack.Last().NestedSeconds += ElapsedSeconds;
+        }
+    }
+}
+
+FSuzieGenerationProfile::FSuzieGenerationProfile() : StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FSuzieGenerationProfile::CountObject(const FString& ObjectType)
+{
+    ObjectCounts.FindOrAdd(ObjectType)++;
+}
+
+bool FSuzieGenerationProfile::Save(const FString& FilePath, const int32 NumMostExpensiveTypes) const
+{
+    const TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    RootObject->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+    RootObject->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+    RootObject->SetNumberField(TEXT("total_seconds"), FPlatformTime::Seconds() - StartTime);
+    RootObject->SetNumberField(TEXT("peak_used_physical_bytes"), static_cast<double>(FPlatformMemory::GetStats().PeakUsedPhysical));
+
+    TArray<TSharedPtr<FJsonValue>> PhaseValues;
+    for (const FPhase& Phase : Phases)
+    {
+        const TSharedPtr<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+        PhaseObject->SetStringField(TEXT("name"), Phase.Name);
+        PhaseObject->SetNumberField(TEXT("seconds"), Phase.Seconds);
+        PhaseObject->SetNumberField(TEXT("used_physical_bytes"), static_cast<double>(Phase.UsedPhysicalBytes));
+        PhaseValues.Add(MakeShared<FJsonValueObject>(PhaseObject));
+    }
+    RootObject->SetArrayField(TEXT("phases"), PhaseValues);
+
+    TArray<TSharedPtr<FJsonValue>> FileValues;
+    for (const FFile& File : Files)
+    {
+        const TSharedPtr<FJsonObject> FileObject = MakeShared<FJsonObject>();
+        FileObject->SetStringField(TEXT("name"), File.Name);
+        FileObject->SetNumberField(TEXT("seconds"), File.Seconds);
+        FileObject->SetNumberField(TEXT("size_bytes"), static_cast<double>(File.SizeBytes));
+        FileValues.Add(MakeShared<FJsonValueObject>(FileObject));
+    }
+    RootObject->SetArrayField(TEXT("files"), FileValues);
+
+    const TSharedPtr<FJsonObject> ObjectCountsObject = MakeShared<FJsonObject>();
+    for (const auto& [ObjectType, ObjectCount] : ObjectCounts)
+    {
+        ObjectCountsObject->SetNumberField(ObjectType, ObjectCount);
+    }
+    RootObject->SetObjectField(TEXT("object_counts"), ObjectCountsObject);
+
+    TArray<TPair<FString, double>> SortedTypeSeconds = TypeSeconds.Array();
+    SortedTypeSeconds.Sort([](const TPair<FString, double>& A, const TPair<FString, double>& B) { return A.Value > B.Value; });
+    TArray<TSharedPtr<FJsonValue>> TypeValues;
+    for (int32 TypeIndex = 0; TypeIndex < FMath::Min(NumMostExpensiveTypes, SortedTypeSeconds.Num()); TypeIndex++)
+    {
+        const TSharedPtr<FJsonObject> TypeObject = MakeShared<FJsonObject>();
+        TypeObject->SetStringField(TEXT("path"), SortedTypeSeconds[TypeIndex].Key);
+        TypeObject->SetNumberField(TEXT("seconds"), SortedTypeSeconds[TypeIndex].Value);
+        TypeValues.Add(MakeShared<FJsonValueObject>(TypeObject));
+    }
+    RootObject->SetArrayField(TEXT("most_expensive_types"), TypeValues);
+
+    FString ProfileContent;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ProfileContent);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer) || !FFileHelper::SaveStringToFile(ProfileContent, *FilePath))
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Failed to write generation profile: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
+
+bool FSuzieGenerationProfile::CheckBudgets(const TSharedPtr<FJsonObject>& PreviousProfile, const TMap<FString, float>& PhaseBudgets, const float RegressionThresholdPercent, const bool bLogAsErrors) const
+{
+    const TMap<FString, double> PreviousPhaseSeconds = GetProfilePhaseSeconds(PreviousProfile);
+
+    bool bAnyPhaseOverBudget = false;
+    auto ReportPhase = [&](const FString& Message)
+    {
+        if (bLogAsErrors)
+        {
+            UE_LOG(LogSuzie, Error, TEXT("%s"), *Message);
+        }
+        else
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("%s"), *Message);
+        }
+        bAnyPhaseOverBudget = true;
+    };
+    for (const FPhase& Phase : Phases)
+    {
+        if (const float* BudgetSeconds = PhaseBudgets.Find(Phase.Name); BudgetSeconds && Phase.Seconds > *BudgetSeconds)
+        {
+            ReportPhase(FString::Printf(TEXT("Generation phase %s took %.2f seconds, over its budget of %.2f seconds"), *Phase.Name, Phase.Seconds, *BudgetSeconds));
+        }
+        const double* PreviousSeconds = PreviousPhaseSeconds.Find(Phase.Name);
+        if (RegressionThresholdPercent > 0.0f && PreviousSeconds && Phase.Seconds > MinRegressionSeconds &&
+            Phase.Seconds > *PreviousSeconds * (1.0 + RegressionThresholdPercent / 100.0))
+        {
+            ReportPhase(FString::Printf(TEXT("Generation phase %s took %.2f seconds, %.0f%% slower than the %.2f seconds of the previous run"),
+                *Phase.Name, Phase.Seconds, (Phase.Seconds / FMath::Max(*PreviousSeconds, UE_DOUBLE_SMALL_NUMBER) - 1.0) * 100.0, *PreviousSeconds));
+        }
+    }
+    return bAnyPhaseOverBudget;
+}
+
+bool FSuzieGenerationProfile::CompareWithBaseline(const TSharedPtr<FJsonObject>& Profile, const TSharedPtr<FJsonObject>& BaselineProfile, const float RegressionThresholdPercent)
+{
+    const TMap<FString, double> BaselinePhaseSeconds = GetProfilePhaseSeconds(BaselineProfile);
+    bool bAnyPhaseRegressed = false;
+    UE_LOG(LogSuzie, Display, TEXT("  %-24s %10s %10s %8s"), TEXT("Phase"), TEXT("Seconds"), TEXT("Baseline"), TEXT("Change"));
+    for (const auto& [PhaseName, Seconds] : GetProfilePhaseSeconds(Profile))
+    {
+        const double* BaselineSeconds = BaselinePhaseSeconds.Find(PhaseName);
+        if (BaselineSeconds == nullptr)
+        {
+            UE_LOG(LogSuzie, Display, TEXT("  %-24s %10.3f %10s %8s"), *PhaseName, Seconds, TEXT("-"), TEXT("-"));
+            continue;
+        }
+        const double ChangePercent = (Seconds / FMath::Max(*BaselineSeconds, UE_DOUBLE_SMALL_NUMBER) - 1.0) * 100.0;
+        const bool bRegressed = RegressionThresholdPercent > 0.0f && Seconds > MinRegressionSeconds && ChangePercent > RegressionThresholdPercent;
+        if (bRegressed)
+        {
+            UE_LOG(LogSuzie, Error, TEXT("  %-24s %10.3f %10.3f %+7.1f%% over the %.0f%% threshold"), *PhaseName, Seconds, *BaselineSeconds, ChangePercent, RegressionThresholdPercent);
+        }
+        else
+        {
+            UE_LOG(LogSuzie, Display, TEXT("  %-24s %10.3f %10.3f %+7.1f%%"), *PhaseName, Seconds, *BaselineSeconds, ChangePercent);
+        }
+        bAnyPhaseRegressed |= bRegressed;
+    }
+    return bAnyPhaseRegressed;
+}
+
+TSharedPtr<FJsonObject> FSuzieGenerationProfile::Load(const FString& FilePath)
+{
+    FString ProfileContent;
+    if (!FFileHelper::LoadFileToString(ProfileContent, *FilePath))
+    {
+        return nullptr;
+    }
+    TSharedPtr<FJsonObject> RootObject;
+    const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(ProfileContent);
+    return FJsonSerializer::Deserialize(Reader, RootObject) ? RootObject : nullptr;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+// Wall time and memory of a single generation run, written to Saved/Suzie so that runs can be compared with each other
+class FSuzieGenerationProfile
+{
+public:
+    // Records the time of the phase from its construction to its destruction. Does nothing without a profile
+    class FScopedPhase
+    {
+    public:
+        FScopedPhase(FSuzieGenerationProfile* InProfile, const TCHAR* PhaseName);
+        ~FScopedPhase();
+    private:
+        FSuzieGenerationProfile* Profile;
+        FString Name;
+        double StartTime;
+    };
+    // Records the time spent loading the dump file from its construction to its destruction. Does nothing without a profile
+    class FScopedFile
+    {
+    public:
+        FScopedFile(FSuzieGenerationProfile* InProfile, const FString& InFilePath);
+        ~FScopedFile();
+    private:
+        FSuzieGenerationProfile* Profile;
+        FString FilePath;
+        double StartTime;
+    };
+    // Records the time spent on the type, excluding the time spent on other types created or finalized while this one is. Does nothing without a profile
+    class FScopedType
+    {
+    public:
+        FScopedType(FSuzieGenerationProfile* InProfile, const FString& TypePath);
+        ~FScopedType();
+    private:
+        FSuzieGenerationProfile* Profile;
+    };
+
+    FSuzieGenerationProfile();
+
+    void CountObject(const FString& ObjectType);
+    /** Writes the profile as JSON, with the given number of most expensive types */
+    bool Save(const FString& FilePath, int32 NumMostExpensiveTypes) const;
+    /** Logs phases that exceed their budget in seconds, or are slower than in the previous profile by more than the threshold percentage. Returns true if any did */
+    bool CheckBudgets(const TSharedPtr<FJsonObject>& PreviousProfile, const TMap<FString, float>& PhaseBudgets, float RegressionThresholdPercent, bool bLogAsErrors) const;
+    /** Logs the phase times of the profile next to the ones of the baseline profile. Returns true if any phase is slower than in the baseline by more than the threshold percentage */
+    static bool CompareWithBaseline(const TSharedPtr<FJsonObject>& Profile, const TSharedPtr<FJsonObject>& BaselineProfile, float RegressionThresholdPercent);
+    /** Reads a profile written by an earlier run, or returns nullptr if there is none */
+    static TSharedPtr<FJsonObject> Load(const FString& FilePath);
+private:
+    struct FPhase
+    {
+        FString Name;
+        double Seconds{};
+        uint64 UsedPhysicalBytes{};
+    };
+    struct FFile
+    {
+        FString Name;
+        double Seconds{};
+        int64 SizeBytes{};
+    };
+    struct FTypeStackEntry
+    {
+        FString TypePath;
+        double StartTime{};
+        double NestedSeconds{};
+    };
+
+    double StartTime{};
+    TArray<FPhase> Phases;
+    TArray<FFile> Files;
+    TMap<FString, int32> ObjectCounts;
+    TMap<FString, double> TypeSeconds;
+    TArray<FTypeStackEntry> TypeStack;
+};
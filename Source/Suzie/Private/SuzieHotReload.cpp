@@ -0,0 +1,506 @@
+#include "SuziePlugin.h"
+#include "SuzieDecompressionHelper.h"
+#include "SuzieSettings.h"
+#include "SuzieTrace.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Editor/EditorEngine.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/KismetReinstanceUtilities.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/ArchiveReplaceObjectRef.h"
+#include "SuzieGeneratedObjectReferencer.h"
+#include "UObject/UObjectIterator.h"
+
+#define LOCTEXT_NAMESPACE "FSuziePluginModule"
+
+// Hashes the JSON value including all of its nested values. String hashes are case-sensitive, unlike GetTypeHash for FString
+uint32 FSuziePluginModule::HashJsonValue(const TSharedPtr<FJsonValue>& JsonValue)
+{
+    if (!JsonValue.IsValid())
+    {
+        return 0;
+    }
+    uint32 Hash = GetTypeHash(static_cast<uint8>(JsonValue->Type));
+    switch (JsonValue->Type)
+    {
+    case EJson::String:
+        Hash = HashCombine(Hash, FCrc::StrCrc32(*JsonValue->AsString()));
+        break;
+    case EJson::Number:
+        Hash = HashCombine(Hash, GetTypeHash(JsonValue->AsNumber()));
+        break;
+    case EJson::Boolean:
+        Hash = HashCombine(Hash, GetTypeHash(JsonValue->AsBool()));
+        break;
+    case EJson::Array:
+        for (const TSharedPtr<FJsonValue>& ElementValue : JsonValue->AsArray())
+        {
+            Hash = HashCombine(Hash, HashJsonValue(ElementValue));
+        }
+        break;
+    case EJson::Object:
+        for (const auto& [FieldName, FieldValue] : JsonValue->AsObject()->Values)
+        {
+            Hash = HashCombine(Hash, HashCombine(FCrc::StrCrc32(*FieldName), HashJsonValue(FieldValue)));
+        }
+        break;
+    default:
+        break;
+    }
+    return Hash;
+}
+
+// Folds the object and its nested subobjects into the hashes. Names, classes and flags of the objects determine which default subobjects are created,
+// so they are a part of the class structure, while the property values only affect the default values
+static void HashObjectTree(const TSharedPtr<FJsonObject>& Objects, const FString& ObjectPath, FDynamicTypeDefinitionHashes& InOutHashes)
+{
+    const TSharedPtr<FJsonObject>* ObjectDefinition;
+    if (!Objects->TryGetObjectField(ObjectPath, ObjectDefinition))
+    {
+        return;
+    }
+    InOutHashes.StructuralHash = HashCombine(InOutHashes.StructuralHash, FCrc::StrCrc32(*ObjectPath));
+    InOutHashes.StructuralHash = HashCombine(InOutHashes.StructuralHash, FCrc::StrCrc32(*(*ObjectDefinition)->GetStringField(TEXT("class"))));
+    InOutHashes.StructuralHash = HashCombine(InOutHashes.StructuralHash, FCrc::StrCrc32(*(*ObjectDefinition)->GetStringField(TEXT("object_flags"))));
+    InOutHashes.DefaultValuesHash = HashCombine(InOutHashes.DefaultValuesHash, HashJsonValue((*ObjectDefinition)->TryGetField(TEXT("property_values"))));
+
+    const TArray<TSharedPtr<FJsonValue>>* Children;
+    if ((*ObjectDefinition)->TryGetArrayField(TEXT("children"), Children))
+    {
+        for (const TSharedPtr<FJsonValue>& ChildJsonValue : *Children)
+        {
+            HashObjectTree(Objects, ChildJsonValue->AsString(), InOutHashes);
+        }
+    }
+}
+
+static bool IsJsonClassDefinitionFileName(const FString& FileName)
+{
+    return FSuzieDecompressionHelper::RemoveCompressedFileExtension(FileName).EndsWith(TEXT(".jmap")) || FileName.EndsWith(TEXT(".jmapindex"));
+}
+
+void FSuziePluginModule::ComputeTypeDefinitionHashes(const TSharedPtr<FJsonObject>& Objects, TMap<FString, FDynamicTypeDefinitionHashes>& OutTypeHashes)
+{
+    for (const auto& [ObjectPath, ObjectValue] : Objects->Values)
+    {
+        const TSharedPtr<FJsonObject> ObjectDefinition = ObjectValue->AsObject();
+        const FString Type = ObjectDefinition->GetStringField(TEXT("type"));
+
+        FString OuterObjectPath;
+        FString ObjectName;
+        ParseObjectPath(ObjectPath, OuterObjectPath, ObjectName);
+
+        FDynamicTypeDefinitionHashes TypeHashes;
+        if (Type == TEXT("Class"))
+        {
+            // See CreateDynamicClassesForJsonObject for why CDOs can be labeled as classes
+            if (ObjectName.StartsWith(TEXT("Default__")))
+            {
+                continue;
+            }
+            TypeHashes.StructuralHash = HashJsonValue(ObjectValue);
+
+            // Functions are separate objects in the dump, but changing any of them changes the class
+            const TArray<TSharedPtr<FJsonValue>>* Children;
+            if (ObjectDefinition->TryGetArrayField(TEXT("children"), Children))
+            {
+                for (const TSharedPtr<FJsonValue>& ChildJsonValue : *Children)
+                {
+                    TypeHashes.StructuralHash = HashCombine(TypeHashes.StructuralHash, HashJsonValue(Objects->TryGetField(ChildJsonValue->AsString())));
+                }
+            }
+            HashObjectTree(Objects, ObjectDefinition->GetStringField(TEXT("class_default_object")), TypeHashes);
+        }
+        else if (Type == TEXT("ScriptStruct") || Type == TEXT("Enum"))
+        {
+            TypeHashes.StructuralHash = HashJsonValue(ObjectValue);
+        }
+        else if (Type == TEXT("Function") && !OuterObjectPath.Contains(TEXT(".")))
+        {
+            // Only top level functions (delegate signatures) are types of their own, functions in classes are a part of the class hash
+            TypeHashes.StructuralHash = HashJsonValue(ObjectValue);
+        }
+        else
+        {
+            continue;
+        }
+        OutTypeHashes.Add(ObjectPath, TypeHashes);
+    }
+}
+
+void FSuziePluginModule::StartWatchingJsonClassDefinitions()
+{
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+    if (!FPaths::DirectoryExists(JsonClassesPath))
+    {
+        return;
+    }
+
+    IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+    if (DirectoryWatcher == nullptr)
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Directory watcher is not available on this platform, changes to the dumps will not be applied until the editor is restarted"));
+        return;
+    }
+    DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(JsonClassesPath,
+        IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FSuziePluginModule::OnJsonClassDefinitionsDirectoryChanged), DirectoryWatcherHandle);
+}
+
+void FSuziePluginModule::StopWatchingJsonClassDefinitions()
+{
+    if (DirectoryWatcherHandle.IsValid())
+    {
+        FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+        if (DirectoryWatcherModule && DirectoryWatcherModule->Get())
+        {
+            DirectoryWatcherModule->Get()->UnregisterDirectoryChangedCallback_Handle(GetJsonClassDefinitionsDirectory(), DirectoryWatcherHandle);
+        }
+        DirectoryWatcherHandle.Reset();
+    }
+    if (PendingHotReloadTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PendingHotReloadTickerHandle);
+        PendingHotReloadTickerHandle.Reset();
+    }
+}
+
+void FSuziePluginModule::OnJsonClassDefinitionsDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+    for (const FFileChangeData& FileChange : FileChanges)
+    {
+        const FString FileName = FPaths::GetCleanFilename(FileChange.Filename);
+        if (!IsJsonClassDefinitionFileName(FileName))
+        {
+            continue;
+        }
+        FilesPendingHotReload.Add(FileName);
+        LastDirectoryChangeTime = FPlatformTime::Seconds();
+    }
+
+    if (!FilesPendingHotReload.IsEmpty() && !PendingHotReloadTickerHandle.IsValid())
+    {
+        PendingHotReloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSuziePluginModule::ProcessPendingHotReload));
+    }
+}
+
+bool FSuziePluginModule::ProcessPendingHotReload(float DeltaTime)
+{
+    // Wait for the file to stop changing, dumps are large and are usually written in multiple chunks
+    if (FPlatformTime::Seconds() - LastDirectoryChangeTime < GetDefault<USuzieSettings>()->HotReloadDelay)
+    {
+        return true;
+    }
+    // Reinstancing objects of the running game world is not safe, so wait for PIE to end
+    if (GEditor && GEditor->PlayWorld)
+    {
+        return true;
+    }
+
+    UE_LOG(LogSuzie, Display, TEXT("Dumps changed: %s"), *FString::Join(FilesPendingHotReload.Array(), TEXT(", ")));
+    FilesPendingHotReload.Empty();
+    PendingHotReloadTickerHandle.Reset();
+
+    // Dumps are merged into a single index, so any change to any of them (including removals and overlays) is applied by reloading all of them
+    HotReloadJsonClassDefinitions();
+    return false;
+}
+
+void FSuziePluginModule::RetireDynamicClass(UClass* Class)
+{
+    // Move the class and its default objects out of the way so that the new version can be generated under the same path
+    // Old version is kept alive since it is a native class and there might still be objects referencing it until they are reinstanced
+    constexpr ERenameFlags RetiredObjectRenameFlags = REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional;
+    UPackage* TransientPackage = GetTransientPackage();
+
+    if (FDynamicClassConstructionData* ClassConstructionData = DynamicClassConstructionData.Find(Class); ClassConstructionData && ClassConstructionData->DefaultObjectArchetype)
+    {
+        ClassConstructionData->DefaultObjectArchetype->Rename(nullptr, TransientPackage, RetiredObjectRenameFlags);
+    }
+    if (UObject* ClassDefaultObject = Class->GetDefaultObject(false))
+    {
+        ClassDefaultObject->Rename(nullptr, TransientPackage, RetiredObjectRenameFlags);
+    }
+    const FName RetiredClassName = MakeUniqueObjectName(TransientPackage, UClass::StaticClass(), *FString::Printf(TEXT("SUZIE_REINST_%s"), *Class->GetName()));
+    Class->Rename(*RetiredClassName.ToString(), TransientPackage, RetiredObjectRenameFlags);
+    Class->ClassFlags |= CLASS_NewerVersionExists;
+}
+
+void FSuziePluginModule::ReplaceRetiredClassReferences(const TMap<UClass*, UClass*>& OldToNewClassMap)
+{
+    TMap<UObject*, UObject*> ReplacementMap;
+    for (const auto& [OldClass, NewClass] : OldToNewClassMap)
+    {
+        ReplacementMap.Add(OldClass, NewClass);
+    }
+
+    // Types that have not changed are not regenerated, so their properties, function parameters and default values still point at the retired classes.
+    // Serializing a type also visits its properties and the functions inside of it. Default objects live outside of their class, so they are visited separately
+    TArray<UObject*> ObjectsToFixUp;
+    for (UObject* Object : GeneratedObjectReferencer->GetObjects())
+    {
+        // Retired classes, their functions and their archetypes are replaced as a whole
+        if (Object == nullptr || OldToNewClassMap.Contains(Cast<UClass>(Object)) || OldToNewClassMap.Contains(Object->GetTypedOuter<UClass>()) ||
+            OldToNewClassMap.Contains(Object->GetClass()))
+        {
+            continue;
+        }
+        ObjectsToFixUp.Add(Object);
+        if (UClass* Class = Cast<UClass>(Object))
+        {
+            if (UObject* ClassDefaultObject = Class->GetDefaultObject(false))
+            {
+                ObjectsToFixUp.Add(ClassDefaultObject);
+            }
+        }
+    }
+    for (UObject* Object : ObjectsToFixUp)
+    {
+        FArchiveReplaceObjectRef<UObject> ReplaceObjectRefAr(Object, ReplacementMap, EArchiveReplaceObjectFlags::IgnoreOuterRef | EArchiveReplaceObjectFlags::IgnoreArchetypeRef);
+    }
+
+    // Construction data is not visible to the archive, and it decides the classes of the default subobjects created for each instance
+    auto ReplaceClass = [&](UClass*& Class)
+    {
+        if (UClass* const* NewClass = OldToNewClassMap.Find(Class))
+        {
+            Class = *NewClass;
+        }
+    };
+    for (auto& [DynamicClass, ClassConstructionData] : DynamicClassConstructionData)
+    {
+        if (OldToNewClassMap.Contains(DynamicClass))
+        {
+            continue;
+        }
+        for (FDynamicObjectConstructionData& DefaultSubobject : ClassConstructionData.DefaultSubobjects)
+        {
+            ReplaceClass(DefaultSubobject.ObjectClass);
+        }
+        for (FNestedDefaultSubobjectOverrideData& DefaultSubobjectOverride : ClassConstructionData.DefaultSubobjectOverrides)
+        {
+            ReplaceClass(DefaultSubobjectOverride.OverridenClass);
+        }
+    }
+}
+
+void FSuziePluginModule::ReapplyClassDefaultValues(FDynamicClassGenerationContext& Context, UClass* Class, const FString& ClassDefaultObjectPath)
+{
+    // Layout of the class has not changed, so the existing default object and its subobjects can be updated in place
+    UObject* ClassDefaultObject = Class->GetDefaultObject();
+    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, ClassDefaultObject, FindOrAddObjectTreeNode(Context, ClassDefaultObjectPath));
+
+    // Archetype is a copy of the default object, so it has to be re-created. Old one is no longer used for construction
+    FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindChecked(Class);
+    if (UObject* OldArchetype = ClassConstructionData.DefaultObjectArchetype)
+    {
+        OldArchetype->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+        ReleaseGeneratedObject(OldArchetype);
+        ClassConstructionData.DefaultObjectArchetype = nullptr;
+    }
+    CreateDefaultObjectArchetype(Class, ClassConstructionData);
+}
+
+void FSuziePluginModule::HotReloadJsonClassDefinitions()
+{
+    UE_LOG(LogSuzie, Display, TEXT("Hot reloading JSON class definitions"));
+    LLM_SCOPE_BYTAG(Suzie);
+
+    // Changed classes are regenerated from scratch, so they must not have any functions pending creation from the old definitions
+    FlushDeferredFunctions();
+
+    TArray<FString> DumpFileNames;
+    TArray<FString> OverlayFileNames;
+    FindJsonClassDefinitionFiles(DumpFileNames, OverlayFileNames);
+    DumpFileContentHashes.Reset();
+
+    FScopedSlowTask HotReloadTask(DumpFileNames.Num() + 4, LOCTEXT("HotReloadingJsonFiles", "Suzie: Applying changes to the dumps"));
+    HotReloadTask.MakeDialogDelayed(1.0f);
+
+    // Types that became reachable since the last generation (e.g. a new Blueprint parent class) show up as new types
+    TSet<FString> ReachabilitySeedObjectPaths;
+    const bool bOnlyGenerateReachableTypes = GetDefault<USuzieSettings>()->bOnlyGenerateReachableTypes;
+    if (bOnlyGenerateReachableTypes)
+    {
+        GatherReachableTypeSeeds(ReachabilitySeedObjectPaths);
+    }
+    TSharedPtr<FJsonObject> RootObject;
+    if (!LoadMergedJsonClassDefinitions(DumpFileNames, OverlayFileNames, bOnlyGenerateReachableTypes ? &ReachabilitySeedObjectPaths : nullptr, RootObject, HotReloadTask))
+    {
+        return;
+    }
+    const TSharedPtr<FJsonObject>& Objects = RootObject->GetObjectField(TEXT("objects"));
+
+    // Diff the new dumps against the definitions the existing types have been generated from
+    HotReloadTask.EnterProgressFrame(1);
+    TMap<FString, FDynamicTypeDefinitionHashes> NewTypeHashes;
+    ComputeTypeDefinitionHashes(Objects, NewTypeHashes);
+    TMap<FString, FDynamicTypeDefinitionHashes>& OldTypeHashes = GeneratedTypeHashes;
+
+    TMap<UClass*, FString> ClassesWithChangedLayout;
+    TMap<UClass*, FString> ClassesWithChangedDefaults;
+    TMap<UEnum*, FString> ChangedEnums;
+    int32 NumAddedTypes = 0;
+    for (const auto& [TypePath, NewHashes] : NewTypeHashes)
+    {
+        const FDynamicTypeDefinitionHashes* OldHashes = OldTypeHashes.Find(TypePath);
+        if (OldHashes == nullptr)
+        {
+            NumAddedTypes++;
+            continue;
+        }
+        const bool bStructureChanged = OldHashes->StructuralHash != NewHashes.StructuralHash;
+        if (!bStructureChanged && OldHashes->DefaultValuesHash == NewHashes.DefaultValuesHash)
+        {
+            continue;
+        }
+
+        UObject* ExistingType = FindObject<UObject>(nullptr, *TypePath);
+        if (UClass* ExistingClass = Cast<UClass>(ExistingType); ExistingClass && DynamicClassConstructionData.Contains(ExistingClass))
+        {
+            (bStructureChanged ? ClassesWithChangedLayout : ClassesWithChangedDefaults).Add(ExistingClass, TypePath);
+        }
+        else if (UEnum* ExistingEnum = Cast<UEnum>(ExistingType))
+        {
+            ChangedEnums.Add(ExistingEnum, TypePath);
+        }
+        else if (ExistingType != nullptr)
+        {
+            // Structs and delegate signatures are embedded into the layout of other types, so they cannot be safely replaced at runtime
+            UE_LOG(LogSuzie, Warning, TEXT("Definition of %s has changed. Changes to structs and delegate signatures will be applied after the editor is restarted"), *TypePath);
+        }
+    }
+    for (const auto& [TypePath, OldHashes] : OldTypeHashes)
+    {
+        if (!NewTypeHashes.Contains(TypePath))
+        {
+            UE_LOG(LogSuzie, Display, TEXT("Type %s has been removed from the dumps. It will remain loaded until the editor is restarted"), *TypePath);
+        }
+    }
+
+    // Dynamic classes deriving from a class with changed layout have to be regenerated as well, since their properties are laid out after the parent ones
+    for (const auto& [DynamicClass, ClassConstructionData] : DynamicClassConstructionData)
+    {
+        if (ClassesWithChangedLayout.Contains(DynamicClass) || DynamicClass->HasAnyClassFlags(CLASS_NewerVersionExists))
+        {
+            continue;
+        }
+        for (const auto& [ChangedClass, ChangedClassPath] : ClassesWithChangedLayout)
+        {
+            if (DynamicClass->IsChildOf(ChangedClass))
+            {
+                const FString ChildClassPath = DynamicClass->GetPathName();
+                if (NewTypeHashes.Contains(ChildClassPath))
+                {
+                    ClassesWithChangedLayout.Add(DynamicClass, ChildClassPath);
+                }
+                else
+                {
+                    UE_LOG(LogSuzie, Warning, TEXT("Class %s derives from changed class %s, but is no longer present in the dumps and cannot be regenerated"), *ChildClassPath, *ChangedClassPath);
+                }
+                break;
+            }
+        }
+    }
+    ClassesWithChangedDefaults = ClassesWithChangedDefaults.FilterByPredicate([&](const TPair<UClass*, FString>& Pair) { return !ClassesWithChangedLayout.Contains(Pair.Key); });
+
+    UE_LOG(LogSuzie, Display, TEXT("Hot reload found %d new types, %d classes with changed layout, %d classes with changed default values, %d changed enums"),
+        NumAddedTypes, ClassesWithChangedLayout.Num(), ClassesWithChangedDefaults.Num(), ChangedEnums.Num());
+
+    // Generate new and changed types. Classes with changed layout are moved out of the way first, so the generation will create them from scratch,
+    // while all other types already exist and will be skipped by the generation
+    HotReloadTask.EnterProgressFrame(1);
+    for (const auto& [ChangedClass, ChangedClassPath] : ClassesWithChangedLayout)
+    {
+        RetireDynamicClass(ChangedClass);
+    }
+    // Prototypes may reference the retired classes, and the descriptors of the changed types may have the same shape as before
+    ResetPropertyPrototypes();
+    for (const auto& [ChangedEnum, ChangedEnumPath] : ChangedEnums)
+    {
+        const TSharedPtr<FJsonObject> EnumDefinition = Objects->GetObjectField(ChangedEnumPath);
+        TArray<TPair<FName, int64>> EnumNames;
+        for (const TSharedPtr<FJsonValue>& EnumNameAndValueArrayValue : EnumDefinition->GetArrayField(TEXT("names")))
+        {
+            const TArray<TSharedPtr<FJsonValue>>& EnumNameAndValueArray = EnumNameAndValueArrayValue->AsArray();
+            if (EnumNameAndValueArray.Num() == 2)
+            {
+                EnumNames.Add({FName(*EnumNameAndValueArray[0]->AsString()), (int64)EnumNameAndValueArray[1]->AsNumber()});
+            }
+        }
+        // Enum constants are only referenced by value, so they can be replaced in place
+        ChangedEnum->SetEnums(EnumNames, ChangedEnum->GetCppForm(), ChangedEnum->HasAnyEnumFlags(EEnumFlags::Flags) ? EEnumFlags::Flags : EEnumFlags::None, false);
+    }
+    CreateDynamicClassesForJsonObject(RootObject);
+
+    FDynamicClassGenerationContext ClassGenerationContext;
+    ClassGenerationContext.GlobalObjectMap = Objects;
+    ClassGenerationContext.SkippedObjectPaths = &SkippedObjectPaths;
+    SetupOnDemandObjectDefinitions(ClassGenerationContext);
+    for (const auto& [ChangedClass, ChangedClassPath] : ClassesWithChangedDefaults)
+    {
+        const TSharedPtr<FJsonObject> ClassDefinition = Objects->GetObjectField(ChangedClassPath);
+        ReapplyClassDefaultValues(ClassGenerationContext, ChangedClass, ClassDefinition->GetStringField(TEXT("class_default_object")));
+    }
+
+    // Replace instances of the old classes with instances of the new ones
+    HotReloadTask.EnterProgressFrame(1);
+    TMap<UClass*, UClass*> OldToNewClassMap;
+    for (const auto& [OldClass, ClassPath] : ClassesWithChangedLayout)
+    {
+        if (UClass* NewClass = FindObject<UClass>(nullptr, *ClassPath))
+        {
+            OldToNewClassMap.Add(OldClass, NewClass);
+        }
+    }
+    if (!OldToNewClassMap.IsEmpty())
+    {
+        ReplaceRetiredClassReferences(OldToNewClassMap);
+        FBlueprintCompileReinstancer::BatchReplaceInstancesOfClass(OldToNewClassMap);
+    }
+
+    // Reparent and recompile Blueprints deriving from the changed classes so they pick up new layouts and default values
+    TArray<UClass*> ChangedClasses;
+    ClassesWithChangedLayout.GenerateKeyArray(ChangedClasses);
+    for (const auto& [ChangedClass, ChangedClassPath] : ClassesWithChangedDefaults)
+    {
+        ChangedClasses.Add(ChangedClass);
+    }
+
+    TArray<UBlueprint*> BlueprintsToRecompile;
+    for (TObjectIterator<UBlueprint> BlueprintIterator; BlueprintIterator; ++BlueprintIterator)
+    {
+        UBlueprint* Blueprint = *BlueprintIterator;
+        if (Blueprint->ParentClass == nullptr)
+        {
+            continue;
+        }
+        if (UClass* const* NewParentClass = OldToNewClassMap.Find(Blueprint->ParentClass))
+        {
+            Blueprint->ParentClass = *NewParentClass;
+            BlueprintsToRecompile.Add(Blueprint);
+            continue;
+        }
+        for (const UClass* ChangedClass : ChangedClasses)
+        {
+            if (Blueprint->ParentClass->IsChildOf(ChangedClass))
+            {
+                BlueprintsToRecompile.Add(Blueprint);
+                break;
+            }
+        }
+    }
+    for (UBlueprint* Blueprint : BlueprintsToRecompile)
+    {
+        FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+        FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+    }
+
+    OldTypeHashes = MoveTemp(NewTypeHashes);
+    UE_LOG(LogSuzie, Display, TEXT("Finished hot reloading, reinstanced %d classes and recompiled %d blueprints"), OldToNewClassMap.Num(), BlueprintsToRecompile.Num());
+}
+
+#undef LOCTEXT_NAMESPACE
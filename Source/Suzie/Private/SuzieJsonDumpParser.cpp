@@ -0,0 +1,151 @@
+#include "SuzieJsonDumpParser.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+bool FSuzieJsonDumpParser::ParseDump(const FString& JsonContent, TFunctionRef<bool(const FString&)> ShouldSkipObject, TSharedPtr<FJsonObject>& OutRootObject, TSet<FString>& OutSkippedObjectPaths, FString& OutErrorMessage)
+{
+    TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(JsonContent);
+
+    EJsonNotation Notation;
+    if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+    {
+        OutErrorMessage = Reader->GetErrorMessage().IsEmpty() ? TEXT("Root value is not an object") : Reader->GetErrorMessage();
+        return false;
+    }
+
+    // This follows what FJsonSerializer does, except for the objects map which is read entry by entry so that the entries can be skipped
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    while (true)
+    {
+        if (!Reader->ReadNext(Notation))
+        {
+            OutErrorMessage = Reader->GetErrorMessage();
+            return false;
+        }
+        if (Notation == EJsonNotation::ObjectEnd)
+        {
+            break;
+        }
+
+        const FString FieldName = Reader->GetIdentifier();
+        if (FieldName == TEXT("objects") && Notation == EJsonNotation::ObjectStart)
+        {
+            TSharedPtr<FJsonObject> Objects = MakeShared<FJsonObject>();
+            if (!ReadObjectMap(*Reader, ShouldSkipObject, Objects, OutSkippedObjectPaths))
+            {
+                OutErrorMessage = Reader->GetErrorMessage();
+                return false;
+            }
+            RootObject->Values.Add(FieldName, MakeShared<FJsonValueObject>(Objects));
+            continue;
+        }
+
+        const TSharedPtr<FJsonValue> FieldValue = ReadValue(*Reader, Notation);
+        if (!FieldValue.IsValid())
+        {
+            OutErrorMessage = Reader->GetErrorMessage();
+            return false;
+        }
+        RootObject->Values.Add(FieldName, FieldValue);
+    }
+    OutRootObject = RootObject;
+    return true;
+}
+
+TSharedPtr<FJsonValue> FSuzieJsonDumpParser::ReadValue(TJsonReader<TCHAR>& Reader, EJsonNotation Notation)
+{
+    switch (Notation)
+    {
+    case EJsonNotation::ObjectStart:
+        {
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            if (!ReadObjectFields(Reader, Object))
+            {
+                return nullptr;
+            }
+            return MakeShared<FJsonValueObject>(Object);
+        }
+    case EJsonNotation::ArrayStart:
+        {
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            EJsonNotation ElementNotation;
+            while (Reader.ReadNext(ElementNotation))
+            {
+                if (ElementNotation == EJsonNotation::ArrayEnd)
+                {
+                    return MakeShared<FJsonValueArray>(Elements);
+                }
+                const TSharedPtr<FJsonValue> ElementValue = ReadValue(Reader, ElementNotation);
+                if (!ElementValue.IsValid())
+                {
+                    return nullptr;
+                }
+                Elements.Add(ElementValue);
+            }
+            return nullptr;
+        }
+    case EJsonNotation::String:
+        return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+    case EJsonNotation::Number:
+        return MakeShared<FJsonValueNumber>(Reader.GetValueAsNumber());
+    case EJsonNotation::Boolean:
+        return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+    case EJsonNotation::Null:
+        return MakeShared<FJsonValueNull>();
+    default:
+        return nullptr;
+    }
+}
+
+bool FSuzieJsonDumpParser::ReadObjectFields(TJsonReader<TCHAR>& Reader, const TSharedPtr<FJsonObject>& Object)
+{
+    EJsonNotation Notation;
+    while (Reader.ReadNext(Notation))
+    {
+        if (Notation == EJsonNotation::ObjectEnd)
+        {
+            return true;
+        }
+        // Identifier is overwritten when reading nested values, so it needs to be copied first
+        FString FieldName = Reader.GetIdentifier();
+        const TSharedPtr<FJsonValue> FieldValue = ReadValue(Reader, Notation);
+        if (!FieldValue.IsValid())
+        {
+            return false;
+        }
+        Object->Values.Add(MoveTemp(FieldName), FieldValue);
+    }
+    return false;
+}
+
+bool FSuzieJsonDumpParser::ReadObjectMap(TJsonReader<TCHAR>& Reader, TFunctionRef<bool(const FString&)> ShouldSkipObject, const TSharedPtr<FJsonObject>& Objects, TSet<FString>& OutSkippedObjectPaths)
+{
+    EJsonNotation Notation;
+    while (Reader.ReadNext(Notation))
+    {
+        if (Notation == EJsonNotation::ObjectEnd)
+        {
+            return true;
+        }
+        FString ObjectPath = Reader.GetIdentifier();
+
+        // Skipped objects are only tokenized to find where they end, no values are allocated for them
+        if (Notation == EJsonNotation::ObjectStart && ShouldSkipObject(ObjectPath))
+        {
+            if (!Reader.SkipObject())
+            {
+                return false;
+            }
+            OutSkippedObjectPaths.Add(MoveTemp(ObjectPath));
+            continue;
+        }
+
+        const TSharedPtr<FJsonValue> ObjectValue = ReadValue(Reader, Notation);
+        if (!ObjectValue.IsValid())
+        {
+            return false;
+        }
+        Objects->Values.Add(MoveTemp(ObjectPath), ObjectValue);
+    }
+    return false;
+}
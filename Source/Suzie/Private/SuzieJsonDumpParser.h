@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonReader.h"
+
+class FJsonObject;
+class FJsonValue;
+
+class FSuzieJsonDumpParser
+{
+public:
+    /** Parses the dump into a JSON object. Entries of the objects map for which ShouldSkipObject returns true are skipped without being parsed, and their paths are added to OutSkippedObjectPaths */
+    static bool ParseDump(const FString& JsonContent, TFunctionRef<bool(const FString&)> ShouldSkipObject, TSharedPtr<FJsonObject>& OutRootObject, TSet<FString>& OutSkippedObjectPaths, FString& OutErrorMessage);
+private:
+    static TSharedPtr<FJsonValue> ReadValue(TJsonReader<TCHAR>& Reader, EJsonNotation Notation);
+    static bool ReadObjectFields(TJsonReader<TCHAR>& Reader, const TSharedPtr<FJsonObject>& Object);
+    static bool ReadObjectMap(TJsonReader<TCHAR>& Reader, TFunctionRef<bool(const FString&)> ShouldSkipObject, const TSharedPtr<FJsonObject>& Objects, TSet<FString>& OutSkippedObjectPaths);
+};
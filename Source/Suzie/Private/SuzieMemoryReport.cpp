@@ -0,0 +1,203 @@
+#include "SuzieMemoryReport.h"
+#include "SuziePlugin.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UnrealType.h"
+
+// Same measurement as obj list uses
+static int64 CountObjectBytes(UObject* Object)
+{
+    FArchiveCountMem CountMem(Object);
+    return CountMem.GetMax();
+}
+
+static int64 CountObjectAndSubobjectBytes(UObject* Object)
+{
+    int64 Bytes = CountObjectBytes(Object);
+    ForEachObjectWithOuter(Object, [&](UObject* Subobject) { Bytes += CountObjectBytes(Subobject); }, true);
+    return Bytes;
+}
+
+static int64 CountMetaDataMapBytes(const TMap<FName, FString>* MetaDataMap)
+{
+    if (MetaDataMap == nullptr)
+    {
+        return 0;
+    }
+    int64 Bytes = MetaDataMap->GetAllocatedSize();
+    for (const auto& [Key, Value] : *MetaDataMap)
+    {
+        Bytes += Value.GetAllocatedSize();
+    }
+    return Bytes;
+}
+
+static int64 CountObjectMetaDataBytes(const UObject* Object)
+{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+    return CountMetaDataMapBytes(FMetaData::GetMapForObject(Object));
+#else
+    return CountMetaDataMapBytes(UMetaData::GetMapForObject(Object));
+#endif
+}
+
+// Fields are not objects, so their memory is estimated from their number. Inner properties of containers are counted as well
+static void CountFieldBytes(const FField* Field, int64& InOutPropertyBytes, int64& InOutMetaDataBytes)
+{
+    InOutPropertyBytes += sizeof(FProperty);
+#if WITH_METADATA
+    InOutMetaDataBytes += CountMetaDataMapBytes(Field->GetMetaDataMap());
+#endif
+    TArray<FField*> InnerFields;
+    Field->GetInnerFields(InnerFields);
+    for (const FField* InnerField : InnerFields)
+    {
+        CountFieldBytes(InnerField, InOutPropertyBytes, InOutMetaDataBytes);
+    }
+}
+
+static void CountStructFieldBytes(const UStruct* Struct, int64& InOutPropertyBytes, int64& InOutMetaDataBytes)
+{
+    for (const FField* Field = Struct->ChildProperties; Field; Field = Field->Next)
+    {
+        CountFieldBytes(Field, InOutPropertyBytes, InOutMetaDataBytes);
+    }
+}
+
+void FSuziePluginModule::GatherGeneratedTypeMemory(TArray<FSuzieTypeMemory>& OutTypeMemory, TArray<FSuzieTypeMemory>& OutPackageMemory)
+{
+    TArray<FSuzieTypeMemory>& TypeMemory = OutTypeMemory;
+    TypeMemory.Reset();
+    for (UObject* GeneratedObject : GetGeneratedObjects())
+    {
+        // Functions of classes and default objects are attributed to their class, archetypes are attributed to the class they are archetypes of
+        UStruct* Struct = Cast<UStruct>(GeneratedObject);
+        const bool bIsClassFunction = Struct && Struct->IsA<UFunction>() && Struct->GetOuter()->IsA<UClass>();
+        if (GeneratedObject == nullptr || bIsClassFunction || !(Struct || GeneratedObject->IsA<UEnum>()))
+        {
+            continue;
+        }
+
+        FSuzieTypeMemory& Memory = TypeMemory.AddDefaulted_GetRef();
+        Memory.Type = GeneratedObject->GetClass()->GetName();
+        Memory.Path = GeneratedObject->GetPathName();
+        Memory.PackageName = GeneratedObject->GetOutermost()->GetName();
+        Memory.TypeBytes = CountObjectBytes(GeneratedObject);
+        Memory.MetaDataBytes = CountObjectMetaDataBytes(GeneratedObject);
+        if (Struct)
+        {
+            CountStructFieldBytes(Struct, Memory.PropertyBytes, Memory.MetaDataBytes);
+        }
+
+        if (UClass* Class = Cast<UClass>(GeneratedObject))
+        {
+            ForEachObjectWithOuter(Class, [&](UObject* Object)
+            {
+                if (UFunction* Function = Cast<UFunction>(Object))
+                {
+                    Memory.FunctionBytes += CountObjectBytes(Function);
+                    Memory.MetaDataBytes += CountObjectMetaDataBytes(Function);
+                    CountStructFieldBytes(Function, Memory.FunctionBytes, Memory.MetaDataBytes);
+                }
+            }, false);
+
+            if (UObject* ClassDefaultObject = Class->GetDefaultObject(false))
+            {
+                Memory.DefaultObjectBytes = CountObjectAndSubobjectBytes(ClassDefaultObject);
+            }
+            if (const FDynamicClassConstructionData* ConstructionData = DynamicClassConstructionData.Find(Class))
+            {
+                Memory.ConstructionDataBytes = sizeof(FDynamicClassConstructionData) + ConstructionData->PropertiesToConstruct.GetAllocatedSize() +
+                    ConstructionData->SuppressedDefaultSubobjects.GetAllocatedSize() + ConstructionData->DefaultSubobjects.GetAllocatedSize() +
+                    ConstructionData->DefaultSubobjectOverrides.GetAllocatedSize();
+                for (const FNestedDefaultSubobjectOverrideData& SubobjectOverride : ConstructionData->DefaultSubobjectOverrides)
+                {
+                    Memory.ConstructionDataBytes += SubobjectOverride.SubobjectPath.GetAllocatedSize();
+                }
+                if (ConstructionData->DefaultObjectArchetype)
+                {
+                    Memory.ArchetypeBytes = CountObjectAndSubobjectBytes(ConstructionData->DefaultObjectArchetype);
+                }
+            }
+        }
+    }
+
+    TMap<FString, FSuzieTypeMemory> PackageMemoryByName;
+    for (const FSuzieTypeMemory& Memory : TypeMemory)
+    {
+        FSuzieTypeMemory& PackageMemory = PackageMemoryByName.FindOrAdd(Memory.PackageName);
+        PackageMemory.Type = TEXT("Package");
+        PackageMemory.Path = Memory.PackageName;
+        PackageMemory.PackageName = Memory.PackageName;
+        PackageMemory.Append(Memory);
+    }
+    PackageMemoryByName.GenerateValueArray(OutPackageMemory);
+
+    auto SortByTotalBytes = [](const FSuzieTypeMemory& A, const FSuzieTypeMemory& B) { return A.GetTotalBytes() > B.GetTotalBytes(); };
+    TypeMemory.Sort(SortByTotalBytes);
+    OutPackageMemory.Sort(SortByTotalBytes);
+}
+
+void FSuziePluginModule::ReportGeneratedTypeMemory(const int32 NumLoggedRows)
+{
+    TArray<FSuzieTypeMemory> TypeMemory;
+    TArray<FSuzieTypeMemory> PackageMemory;
+    GatherGeneratedTypeMemory(TypeMemory, PackageMemory);
+
+    FSuzieTypeMemory TotalMemory;
+    for (const FSuzieTypeMemory& Memory : PackageMemory)
+    {
+        TotalMemory.Append(Memory);
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Generated types use %.2f MB: %.2f MB types, %.2f MB properties, %.2f MB functions, %.2f MB default objects, %.2f MB archetypes, %.2f MB construction data, %.2f MB metadata"),
+        TotalMemory.GetTotalBytes() / (1024.0 * 1024.0), TotalMemory.TypeBytes / (1024.0 * 1024.0), TotalMemory.PropertyBytes / (1024.0 * 1024.0),
+        TotalMemory.FunctionBytes / (1024.0 * 1024.0), TotalMemory.DefaultObjectBytes / (1024.0 * 1024.0), TotalMemory.ArchetypeBytes / (1024.0 * 1024.0),
+        TotalMemory.ConstructionDataBytes / (1024.0 * 1024.0), TotalMemory.MetaDataBytes / (1024.0 * 1024.0));
+
+    auto LogRows = [NumLoggedRows](const TCHAR* Title, const TArray<FSuzieTypeMemory>& Rows)
+    {
+        UE_LOG(LogSuzie, Display, TEXT("%s:"), Title);
+        for (int32 RowIndex = 0; RowIndex < FMath::Min(NumLoggedRows, Rows.Num()); RowIndex++)
+        {
+            UE_LOG(LogSuzie, Display, TEXT("  %10.1f KB  %s"), Rows[RowIndex].GetTotalBytes() / 1024.0, *Rows[RowIndex].Path);
+        }
+    };
+    LogRows(TEXT("Most expensive packages"), PackageMemory);
+    LogRows(TEXT("Most expensive types"), TypeMemory);
+
+    auto WriteCsv = [](const FString& FilePath, const TArray<FSuzieTypeMemory>& Rows)
+    {
+        TArray<FString> Lines;
+        Lines.Reserve(Rows.Num() + 1);
+        Lines.Add(TEXT("Type,Path,Package,TotalBytes,TypeBytes,PropertyBytes,FunctionBytes,DefaultObjectBytes,ArchetypeBytes,ConstructionDataBytes,MetaDataBytes"));
+        for (const FSuzieTypeMemory& Row : Rows)
+        {
+            Lines.Add(FString::Printf(TEXT("%s,%s,%s,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld"), *Row.Type, *Row.Path, *Row.PackageName, Row.GetTotalBytes(),
+                Row.TypeBytes, Row.PropertyBytes, Row.FunctionBytes, Row.DefaultObjectBytes, Row.ArchetypeBytes, Row.ConstructionDataBytes, Row.MetaDataBytes));
+        }
+        if (FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+        {
+            UE_LOG(LogSuzie, Display, TEXT("Wrote %s"), *FilePath);
+        }
+        else
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("Failed to write %s"), *FilePath);
+        }
+    };
+    const FString ReportDirectory = FPaths::ProjectSavedDir() / TEXT("Suzie");
+    WriteCsv(ReportDirectory / TEXT("MemReport_Types.csv"), TypeMemory);
+    WriteCsv(ReportDirectory / TEXT("MemReport_Packages.csv"), PackageMemory);
+}
+
+static FAutoConsoleCommand MemReportCommand(
+    TEXT("Suzie.MemReport"),
+    TEXT("Logs the memory used by the generated types and their packages, and writes the full report to Saved/Suzie/MemReport_Types.csv and MemReport_Packages.csv. Optional argument is the number of logged rows"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FSuziePluginModule::ReportGeneratedTypeMemory(Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 20);
+    }));
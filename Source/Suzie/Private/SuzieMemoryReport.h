@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Memory attributed to a single generated type, or to all generated types of a package
+struct FSuzieTypeMemory
+{
+    FString Type;
+    FString Path;
+    FString PackageName;
+    int64 TypeBytes{};
+    int64 PropertyBytes{};
+    int64 FunctionBytes{};
+    int64 DefaultObjectBytes{};
+    int64 ArchetypeBytes{};
+    int64 ConstructionDataBytes{};
+    int64 MetaDataBytes{};
+
+    int64 GetTotalBytes() const
+    {
+        return TypeBytes + PropertyBytes + FunctionBytes + DefaultObjectBytes + ArchetypeBytes + ConstructionDataBytes + MetaDataBytes;
+    }
+    void Append(const FSuzieTypeMemory& Other)
+    {
+        TypeBytes += Other.TypeBytes;
+        PropertyBytes += Other.PropertyBytes;
+        FunctionBytes += Other.FunctionBytes;
+        DefaultObjectBytes += Other.DefaultObjectBytes;
+        ArchetypeBytes += Other.ArchetypeBytes;
+        ConstructionDataBytes += Other.ConstructionDataBytes;
+        MetaDataBytes += Other.MetaDataBytes;
+    }
+};
@@ -0,0 +1,127 @@
+#include "SuzieObjectReferenceHelper.h"
+#include "Dom/JsonObject.h"
+
+void FSuzieObjectReferenceHelper::ForEachReferencedObjectPath(const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition, TFunctionRef<void(const FString&)> Callback)
+{
+    // Fields that contain a single object path. Not all of them are present on all object types, and some of them can be null
+    static const TCHAR* ObjectPathFieldNames[] = {
+        TEXT("super_struct"),
+        TEXT("class"),
+        TEXT("class_default_object"),
+    };
+    for (const TCHAR* ObjectPathFieldName : ObjectPathFieldNames)
+    {
+        FString ReferencedObjectPath;
+        if (ObjectDefinition->TryGetStringField(ObjectPathFieldName, ReferencedObjectPath) && !ReferencedObjectPath.IsEmpty())
+        {
+            Callback(ReferencedObjectPath);
+        }
+    }
+
+    // Children are functions for classes and subobjects for other objects
+    const TArray<TSharedPtr<FJsonValue>>* Children;
+    if (ObjectDefinition->TryGetArrayField(TEXT("children"), Children))
+    {
+        for (const TSharedPtr<FJsonValue>& ChildJsonValue : *Children)
+        {
+            Callback(ChildJsonValue->AsString());
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Properties;
+    if (ObjectDefinition->TryGetArrayField(TEXT("properties"), Properties))
+    {
+        for (const TSharedPtr<FJsonValue>& PropertyDescriptor : *Properties)
+        {
+            ForEachPropertyReferencedObjectPath(PropertyDescriptor->AsObject(), Callback);
+        }
+    }
+
+    // Property values can reference classes (e.g. TSubclassOf defaults) and other objects. We cannot tell which strings are object paths
+    // without resolving the properties, so report all of them and let the caller discard the ones that are not known objects
+    if (const TSharedPtr<FJsonValue> PropertyValues = ObjectDefinition->TryGetField(TEXT("property_values")))
+    {
+        ForEachStringValue(PropertyValues, Callback);
+    }
+
+    // Functions need their outer class to exist to be created. Outer of the top level functions is a package and not an object in the dump
+    FString ObjectType;
+    int32 ObjectNameSeparatorIndex;
+    if (ObjectDefinition->TryGetStringField(TEXT("type"), ObjectType) && ObjectType == TEXT("Function") && ObjectPath.FindLastChar('.', ObjectNameSeparatorIndex))
+    {
+        const FString OuterObjectPath = ObjectPath.Left(ObjectNameSeparatorIndex);
+        int32 PackageNameSeparatorIndex;
+        if (OuterObjectPath.FindChar('.', PackageNameSeparatorIndex))
+        {
+            Callback(OuterObjectPath);
+        }
+    }
+}
+
+void FSuzieObjectReferenceHelper::ForEachPropertyReferencedObjectPath(const TSharedPtr<FJsonObject>& PropertyDescriptor, TFunctionRef<void(const FString&)> Callback)
+{
+    if (!PropertyDescriptor.IsValid())
+    {
+        return;
+    }
+
+    // Fields that reference types, see FSuziePluginModule::BuildProperty
+    static const TCHAR* TypeFieldNames[] = {
+        TEXT("property_class"),
+        TEXT("meta_class"),
+        TEXT("interface_class"),
+        TEXT("struct"),
+        TEXT("enum"),
+        TEXT("signature_function"),
+    };
+    for (const TCHAR* TypeFieldName : TypeFieldNames)
+    {
+        FString ReferencedObjectPath;
+        if (PropertyDescriptor->TryGetStringField(TypeFieldName, ReferencedObjectPath) && !ReferencedObjectPath.IsEmpty())
+        {
+            Callback(ReferencedObjectPath);
+        }
+    }
+
+    // Nested properties of containers and enums
+    static const TCHAR* InnerPropertyFieldNames[] = {
+        TEXT("inner"),
+        TEXT("key_prop"),
+        TEXT("value_prop"),
+        TEXT("container"),
+    };
+    for (const TCHAR* InnerPropertyFieldName : InnerPropertyFieldNames)
+    {
+        const TSharedPtr<FJsonObject>* InnerPropertyDescriptor;
+        if (PropertyDescriptor->TryGetObjectField(InnerPropertyFieldName, InnerPropertyDescriptor))
+        {
+            ForEachPropertyReferencedObjectPath(*InnerPropertyDescriptor, Callback);
+        }
+    }
+}
+
+void FSuzieObjectReferenceHelper::ForEachStringValue(const TSharedPtr<FJsonValue>& JsonValue, TFunctionRef<void(const FString&)> Callback)
+{
+    if (!JsonValue.IsValid())
+    {
+        return;
+    }
+    if (JsonValue->Type == EJson::String)
+    {
+        Callback(JsonValue->AsString());
+    }
+    else if (JsonValue->Type == EJson::Array)
+    {
+        for (const TSharedPtr<FJsonValue>& ElementValue : JsonValue->AsArray())
+        {
+            ForEachStringValue(ElementValue, Callback);
+        }
+    }
+    else if (JsonValue->Type == EJson::Object)
+    {
+        for (const auto& [FieldName, FieldValue] : JsonValue->AsObject()->Values)
+        {
+            ForEachStringValue(FieldValue, Callback);
+        }
+    }
+}
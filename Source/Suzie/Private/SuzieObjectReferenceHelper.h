@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+
+class FSuzieObjectReferenceHelper
+{
+public:
+    /** Calls the callback for every object path referenced by the dumped object definition: super structs, property types, signature functions, children, classes of objects and the outer class of functions */
+    static void ForEachReferencedObjectPath(const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition, TFunctionRef<void(const FString&)> Callback);
+
+    /** Calls the callback for every object path referenced by the property descriptor, including its inner properties */
+    static void ForEachPropertyReferencedObjectPath(const TSharedPtr<FJsonObject>& PropertyDescriptor, TFunctionRef<void(const FString&)> Callback);
+private:
+    static void ForEachStringValue(const TSharedPtr<FJsonValue>& JsonValue, TFunctionRef<void(const FString&)> Callback);
+};
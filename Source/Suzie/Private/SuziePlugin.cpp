@@ -1,7 +1,9 @@
 #include "SuziePlugin.h"
 #include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectIterator.h"
 #include "Engine/Blueprint.h"
 #include "UObject/Class.h"
 #include "UObject/UObjectGlobals.h"
@@ -9,15 +11,26 @@
 #include "UObject/ObjectMacros.h"
 #include "UObject/UnrealType.h"
 #include "UObject/PropertyPortFlags.h"
+#include "UObject/MetaData.h"
 #include "HAL/PlatformFileManager.h"
 #include "Editor/EditorEngine.h"
 #include "Framework/Commands/UICommandList.h"
 #include "Engine/EngineTypes.h"
 #include "PropertyEditorModule.h"
 #include "SuzieDecompressionHelper.h"
+#include "SuzieJsonDumpParser.h"
+#include "SuzieGeneratedObjectReferencer.h"
+#include "SuzieSettings.h"
+#include "SuzieDumpSnapshot.h"
+#include "SuzieStreamedDumpIndex.h"
+#include "SuzieTrace.h"
+#include "SuzieGenerationProfile.h"
+#include "SuzieConstructionStats.h"
 #include "Widgets/Docking/SDockTab.h"
+#include "Framework/Application/SlateApplication.h"
 #include "UObject/UObjectAllocator.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Misc/EngineVersion.h"
 #include "Engine/NetConnection.h"
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
 #include "UObject/PropertyOptional.h"
@@ -27,23 +40,596 @@ DEFINE_LOG_CATEGORY(LogSuzie);
 
 #define LOCTEXT_NAMESPACE "FSuziePluginModule"
 
+// Dumps are validated before anything is generated from them when running the validation commandlet, so that broken dumps do not crash it
+static bool IsRunningDumpValidationCommandlet()
+{
+    FString CommandletName;
+    return IsRunningCommandlet() && FParse::Value(FCommandLine::Get(), TEXT("run="), CommandletName) && CommandletName.StartsWith(TEXT("SuzieValidateDumps"));
+}
+
 void FSuziePluginModule::StartupModule()
 {
     UE_LOG(LogSuzie, Display, TEXT("Suzie plugin starting"));
+    LLM_SCOPE_BYTAG(Suzie);
 
-    ProcessAllJsonClassDefinitions();
+    if (!IsRunningDumpValidationCommandlet())
+    {
+        ProcessAllJsonClassDefinitions();
+    }
+
+    // Apply changes to the dumps while the editor is running. There is no point in doing that in commandlets since they do not live long enough.
+    // Streamed dumps are released after generation, so there is nothing to compare the changed dumps against
+    if (GIsEditor && !IsRunningCommandlet() && GetDefault<USuzieSettings>()->bHotReloadChangedDumps && !GetDefault<USuzieSettings>()->bStreamDumps)
+    {
+        StartWatchingJsonClassDefinitions();
+    }
+    if (GIsEditor && !IsRunningCommandlet() && FSlateApplication::IsInitialized())
+    {
+        RegisterDiagnosticsTab();
+    }
 }
 
 void FSuziePluginModule::ShutdownModule()
 {
     UE_LOG(LogSuzie, Display, TEXT("Suzie plugin shutting down"));
+
+    UnregisterDiagnosticsTab();
+    StopWatchingJsonClassDefinitions();
+    StopMaterializingDeferredFunctions();
+    ResetPropertyPrototypes();
+    GeneratedObjectReferencer.Reset();
+}
+
+TArray<TObjectPtr<UObject>> FSuziePluginModule::GetGeneratedObjects()
+{
+    return GeneratedObjectReferencer.IsValid() ? GeneratedObjectReferencer->GetObjects() : TArray<TObjectPtr<UObject>>();
+}
+
+void FSuziePluginModule::KeepGeneratedObjectAlive(UObject* Object)
+{
+    if (!GeneratedObjectReferencer.IsValid())
+    {
+        GeneratedObjectReferencer = MakeUnique<FSuzieGeneratedObjectReferencer>();
+    }
+    GeneratedObjectReferencer->AddObject(Object);
+}
+
+void FSuziePluginModule::ReleaseGeneratedObject(UObject* Object)
+{
+    if (GeneratedObjectReferencer.IsValid())
+    {
+        GeneratedObjectReferencer->RemoveObject(Object);
+    }
+}
+
+void FSuziePluginModule::KeepFieldReferencesAlive(FField* Field)
+{
+    if (!GeneratedObjectReferencer.IsValid())
+    {
+        GeneratedObjectReferencer = MakeUnique<FSuzieGeneratedObjectReferencer>();
+    }
+    GeneratedObjectReferencer->AddField(Field);
+}
+
+void FSuziePluginModule::ReleaseFieldReferences(FField* Field)
+{
+    if (GeneratedObjectReferencer.IsValid())
+    {
+        GeneratedObjectReferencer->RemoveField(Field);
+    }
+}
+
+FString FSuziePluginModule::GetJsonClassDefinitionsDirectory()
+{
+    return BenchmarkDumpDirectory.IsEmpty() ? FPaths::ProjectContentDir() / TEXT("DynamicClasses") : BenchmarkDumpDirectory;
+}
+
+bool FSuziePluginModule::LoadJsonClassDefinitionFileContents(const FString& FilePath, TArray<uint8>& OutFileContents)
+{
+    if (!FSuzieDecompressionHelper::IsCompressedFileName(FilePath))
+    {
+        SUZIE_TRACE_SCOPE(ReadDump);
+        if (!FFileHelper::LoadFileToArray(OutFileContents, *FilePath))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to read JSON file: %s"), *FilePath);
+            return false;
+        }
+        return true;
+    }
+
+    // Read binary file contents. They are released as soon as the file is decompressed
+    TArray<uint8> CompressedFileContents;
+    {
+        SUZIE_TRACE_SCOPE(ReadDump);
+        if (!FFileHelper::LoadFileToArray(CompressedFileContents, *FilePath))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to read compressed JSON file: %s"), *FilePath);
+            return false;
+        }
+    }
+
+    // Attempt to decompress the file with the format matching its extension
+    SUZIE_TRACE_SCOPE(DecompressDump);
+    if (!FSuzieDecompressionHelper::DecompressMemoryForFileName(FilePath, CompressedFileContents, OutFileContents))
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to decompress compressed JSON file: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
+
+bool FSuziePluginModule::IsObjectInPackages(const FString& ObjectPath, const TSet<FString>* PackageNames)
+{
+    if (PackageNames == nullptr || PackageNames->IsEmpty())
+    {
+        return false;
+    }
+    int32 PackageNameSeparatorIndex;
+    return ObjectPath.FindChar('.', PackageNameSeparatorIndex) && PackageNames->Contains(ObjectPath.Left(PackageNameSeparatorIndex));
+}
+
+bool FSuziePluginModule::LoadJsonClassDefinitionFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutRootObject, const TSet<FString>* InSkippedPackageNames, TSet<FString>* OutSkippedObjectPaths)
+{
+    FString JsonContent;
+    if (FSuzieDecompressionHelper::IsCompressedFileName(FilePath))
+    {
+        TArray<uint8> DecompressedFileContents;
+        if (!LoadJsonClassDefinitionFileContents(FilePath, DecompressedFileContents))
+        {
+            return false;
+        }
+
+        // Parse the binary stream into the string. UE will attempt to guess the encoding for us
+        SUZIE_TRACE_SCOPE(DecodeDump);
+        FFileHelper::BufferToString(JsonContent, DecompressedFileContents.GetData(), DecompressedFileContents.Num());
+    }
+    else
+    {
+        SUZIE_TRACE_SCOPE(ReadDump);
+        if (!FFileHelper::LoadFileToString(JsonContent, *FilePath))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to read JSON file: %s"), *FilePath);
+            return false;
+        }
+    }
+
+    // Parse the JSON. Objects in skipped packages are filtered out here, before anything is allocated for them
+    SUZIE_TRACE_SCOPE(ParseDump);
+    TSet<FString> SkippedObjectPaths;
+    FString ParseErrorMessage;
+    const bool bParsedDump = FSuzieJsonDumpParser::ParseDump(JsonContent, [&](const FString& ObjectPath)
+    {
+        return IsObjectInPackages(ObjectPath, InSkippedPackageNames);
+    }, OutRootObject, SkippedObjectPaths, ParseErrorMessage);
+
+    if (!bParsedDump || !OutRootObject.IsValid())
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to parse JSON in file: %s (%s)"), *FilePath, *ParseErrorMessage);
+        return false;
+    }
+    if (!SkippedObjectPaths.IsEmpty())
+    {
+        UE_LOG(LogSuzie, Display, TEXT("Skipped %d objects in native packages while parsing %s"), SkippedObjectPaths.Num(), *FPaths::GetCleanFilename(FilePath));
+    }
+    if (OutSkippedObjectPaths)
+    {
+        OutSkippedObjectPaths->Append(MoveTemp(SkippedObjectPaths));
+    }
+    return true;
+}
+
+void FSuziePluginModule::GatherSkippedPackageNames()
+{
+    SkippedPackageNames.Reset();
+
+    const USuzieSettings* Settings = GetDefault<USuzieSettings>();
+    if (Settings->bSkipObjectsInNativePackages)
+    {
+        // Packages created for dynamic types are marked as compiled in as well, but they have to be parsed to be (re)generated.
+        // Only engine and engine plugin modules are skipped. Modding projects often have a module with the name of the game module,
+        // and skipping its package would drop every type of the game
+        const FString EngineDirectory = FPaths::ConvertRelativePathToFull(FPaths::EngineDir());
+        for (TObjectIterator<UPackage> PackageIt; PackageIt; ++PackageIt)
+        {
+            if (!PackageIt->HasAnyPackageFlags(PKG_CompiledIn) || DynamicPackageNames.Contains(PackageIt->GetFName()))
+            {
+                continue;
+            }
+            FModuleStatus ModuleStatus;
+            if (FModuleManager::Get().QueryModule(FName(*FPackageName::GetShortName(PackageIt->GetName())), ModuleStatus) &&
+                !ModuleStatus.FilePath.IsEmpty() && FPaths::IsUnderDirectory(FPaths::ConvertRelativePathToFull(ModuleStatus.FilePath), EngineDirectory))
+            {
+                SkippedPackageNames.Add(PackageIt->GetName());
+            }
+        }
+    }
+    SkippedPackageNames.Append(Settings->SkippedPackages);
+}
+
+void FSuziePluginModule::FindJsonClassDefinitionFiles(TArray<FString>& OutDumpFileNames, TArray<FString>& OutOverlayFileNames)
+{
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+
+    // Find all JSON files and compressed JSON files
+    TArray<FString> JsonFileNames;
+    IFileManager::Get().FindFiles(JsonFileNames, *JsonClassesPath, TEXT("*.jmap"));
+
+    for (const FString& CompressedFileExtension : FSuzieDecompressionHelper::GetCompressedFileExtensions())
+    {
+        TArray<FString> CompressedJsonFileNames;
+        IFileManager::Get().FindFiles(CompressedJsonFileNames, *JsonClassesPath, *(TEXT("*.jmap") + CompressedFileExtension));
+        JsonFileNames.Append(CompressedJsonFileNames);
+    }
+
+    // Sharded dumps are represented by their index file, shards themselves are loaded through the index
+    TArray<FString> ShardIndexFileNames;
+    IFileManager::Get().FindFiles(ShardIndexFileNames, *JsonClassesPath, TEXT("*.jmapindex"));
+    JsonFileNames.Append(ShardIndexFileNames);
+
+    // Overlays are applied in the order of their file names, so make sure the order does not depend on the file system
+    JsonFileNames.Sort();
+    for (const FString& JsonFileName : JsonFileNames)
+    {
+        (IsOverlayJsonClassDefinitionFile(JsonFileName) ? OutOverlayFileNames : OutDumpFileNames).Add(JsonFileName);
+    }
+}
+
+bool FSuziePluginModule::IsOverlayJsonClassDefinitionFile(const FString& JsonFileName)
+{
+    return FSuzieDecompressionHelper::RemoveCompressedFileExtension(JsonFileName).EndsWith(TEXT(".overlay.jmap"));
+}
+
+FString FSuziePluginModule::GetJsonClassDefinitionDumpName(const FString& JsonFileName)
+{
+    // Dump name is the file name without the extensions, e.g. Game.jmap.gz and Game.jmapindex are named Game
+    FString DumpName = FSuzieDecompressionHelper::RemoveCompressedFileExtension(JsonFileName);
+    DumpName.RemoveFromEnd(TEXT(".jmapindex"));
+    DumpName.RemoveFromEnd(TEXT(".jmap"));
+    return DumpName;
+}
+
+void FSuziePluginModule::LoadJsonClassDefinitionOverlays(const TArray<FString>& OverlayFileNames, TMap<FString, TArray<TSharedPtr<FJsonObject>>>& OutOverlaysByDumpName)
+{
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+    for (const FString& OverlayFileName : OverlayFileNames)
+    {
+        TSharedPtr<FJsonObject> OverlayRootObject;
+        if (!LoadJsonClassDefinitionFile(JsonClassesPath / OverlayFileName, OverlayRootObject, &SkippedPackageNames, &SkippedObjectPaths))
+        {
+            continue;
+        }
+        FString BaseDumpName;
+        if (!OverlayRootObject->TryGetStringField(TEXT("base"), BaseDumpName))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Overlay %s does not specify the name of the base dump it applies to"), *OverlayFileName);
+            continue;
+        }
+        OutOverlaysByDumpName.FindOrAdd(BaseDumpName).Add(OverlayRootObject);
+    }
+}
+
+void FSuziePluginModule::ApplyJsonClassDefinitionOverlay(const TSharedPtr<FJsonObject>& RootObject, const TSharedPtr<FJsonObject>& OverlayRootObject, const bool bAddNewObjects)
+{
+    const TSharedPtr<FJsonObject>* Objects;
+    if (!RootObject->TryGetObjectField(TEXT("objects"), Objects))
+    {
+        return;
+    }
+
+    // Removed objects are applied first, so an overlay can remove an object and add a different one under the same path
+    int32 NumRemovedObjects = 0;
+    const TArray<TSharedPtr<FJsonValue>>* RemovedObjectPaths;
+    if (OverlayRootObject->TryGetArrayField(TEXT("removed_objects"), RemovedObjectPaths))
+    {
+        for (const TSharedPtr<FJsonValue>& RemovedObjectPath : *RemovedObjectPaths)
+        {
+            NumRemovedObjects += (*Objects)->Values.Remove(RemovedObjectPath->AsString());
+        }
+    }
+
+    // Objects in the overlay replace the base objects with the same path entirely
+    int32 NumAddedObjects = 0;
+    int32 NumReplacedObjects = 0;
+    const TSharedPtr<FJsonObject>* OverlayObjects;
+    if (OverlayRootObject->TryGetObjectField(TEXT("objects"), OverlayObjects))
+    {
+        for (const auto& [ObjectPath, ObjectValue] : (*OverlayObjects)->Values)
+        {
+            // Shards only take the objects they contain, new objects have already been added with the shards loaded at startup
+            if (!bAddNewObjects && !(*Objects)->Values.Contains(ObjectPath))
+            {
+                continue;
+            }
+            TSharedPtr<FJsonValue>& BaseObjectValue = (*Objects)->Values.FindOrAdd(ObjectPath);
+            (BaseObjectValue.IsValid() ? NumReplacedObjects : NumAddedObjects)++;
+            BaseObjectValue = ObjectValue;
+        }
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Applied overlay for dump %s: %d objects added, %d replaced, %d removed"),
+        *OverlayRootObject->GetStringField(TEXT("base")), NumAddedObjects, NumReplacedObjects, NumRemovedObjects);
+}
+
+void FSuziePluginModule::MergeJsonClassDefinitionObjects(TMap<FString, TSharedPtr<FJsonValue>>& MergedObjectMap, TMap<FString, TSharedPtr<FJsonValue>>&& ObjectMap, const FString& JsonFileName)
+{
+    if (MergedObjectMap.IsEmpty())
+    {
+        MergedObjectMap = MoveTemp(ObjectMap);
+        return;
+    }
+
+    // Same types are commonly present in multiple dumps (e.g. base game and DLC dumps), only keep one copy of them
+    int32 NumDuplicateObjects = 0;
+    int32 NumConflictingObjects = 0;
+    MergedObjectMap.Reserve(MergedObjectMap.Num() + ObjectMap.Num());
+    for (auto& [ObjectPath, ObjectValue] : ObjectMap)
+    {
+        const uint32 ObjectPathHash = GetTypeHash(ObjectPath);
+        if (const TSharedPtr<FJsonValue>* ExistingObjectValue = MergedObjectMap.FindByHash(ObjectPathHash, ObjectPath))
+        {
+            if (FJsonValue::CompareEqual(**ExistingObjectValue, *ObjectValue))
+            {
+                NumDuplicateObjects++;
+            }
+            else
+            {
+                // Dumps are merged in the order of their file names, so the result does not depend on the file system
+                UE_LOG(LogSuzie, Warning, TEXT("Definition of %s in %s conflicts with its definition in an earlier dump, the earlier definition is used"), *ObjectPath, *JsonFileName);
+                NumConflictingObjects++;
+            }
+            continue;
+        }
+        MergedObjectMap.AddByHash(ObjectPathHash, MoveTemp(ObjectPath), MoveTemp(ObjectValue));
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Merged %s: %d objects added, %d identical duplicates, %d conflicts"),
+        *JsonFileName, ObjectMap.Num() - NumDuplicateObjects - NumConflictingObjects, NumDuplicateObjects, NumConflictingObjects);
+}
+
+bool FSuziePluginModule::LoadMergedJsonClassDefinitions(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, const TSet<FString>* ReachabilitySeedObjectPaths, TSharedPtr<FJsonObject>& OutRootObject, FScopedSlowTask& SlowTask)
+{
+    SUZIE_TRACE_SCOPE(LoadMergedDumps);
+    SUZIE_TRACE_PHASE_MEMORY_SCOPE(SuzieLoadPhaseMemory);
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+
+    // Overlays are small, so load all of them upfront to know which dumps they need to be applied to
+    SlowTask.EnterProgressFrame(1, LOCTEXT("LoadingOverlays", "Loading overlays"));
+    TMap<FString, TArray<TSharedPtr<FJsonObject>>> OverlaysByDumpName;
+    LoadJsonClassDefinitionOverlays(OverlayFileNames, OverlaysByDumpName);
+
+    // Shards that have been loaded on demand before are loaded again, so that the types generated from them are compared against their new definitions
+    const TSet<FString> PreviouslyLoadedShardFilePaths = MoveTemp(LoadedDumpShardFilePaths);
+    LoadedDumpShardFilePaths.Reset();
+    DumpShardFilePathByPackageName.Reset();
+    DumpShardPackageDependencies.Reset();
+    DumpShardDumpNames.Reset();
+    ShardedDumpOverlays.Reset();
+    OnDemandShardObjects.Reset();
+
+    TSharedPtr<FJsonObject> MergedObjects = MakeShared<FJsonObject>();
+    for (const FString& JsonFileName : DumpFileNames)
+    {
+        SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("LoadingJsonFile", "Loading {0}"), FText::AsCultureInvariant(JsonFileName)));
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
+        SlowTask.ForceRefresh();
+#endif
+        UE_LOG(LogSuzie, Display, TEXT("Loading JSON class definition: %s"), *JsonFileName);
+        FSuzieGenerationProfile::FScopedFile ProfileFile(GenerationProfile.Get(), JsonClassesPath / JsonFileName);
+
+        // Read, decompress and parse the JSON file, or the shards of the sharded dump that are needed
+        TSharedPtr<FJsonObject> JsonObject;
+        const bool bIsShardedDump = IsJsonClassDefinitionShardIndexFile(JsonFileName);
+        const bool bLoadedDump = bIsShardedDump ?
+            LoadShardedJsonClassDefinitions(JsonClassesPath / JsonFileName, ReachabilitySeedObjectPaths, PreviouslyLoadedShardFilePaths, JsonObject) :
+            LoadBaseJsonClassDefinitionFile(JsonClassesPath / JsonFileName, JsonObject);
+        if (!bLoadedDump)
+        {
+            continue;
+        }
+
+        // Overlays apply to their base dump only, so they are merged in before the dump is merged with the other dumps
+        const FString DumpName = GetJsonClassDefinitionDumpName(JsonFileName);
+        TArray<TSharedPtr<FJsonObject>> Overlays;
+        if (OverlaysByDumpName.RemoveAndCopyValue(DumpName, Overlays))
+        {
+            for (const TSharedPtr<FJsonObject>& Overlay : Overlays)
+            {
+                ApplyJsonClassDefinitionOverlay(JsonObject, Overlay);
+            }
+            if (bIsShardedDump)
+            {
+                ShardedDumpOverlays.Add(DumpName, Overlays);
+            }
+        }
+
+        const TSharedPtr<FJsonObject>* Objects;
+        if (!JsonObject->TryGetObjectField(TEXT("objects"), Objects))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Missing 'objects' map in %s"), *JsonFileName);
+            continue;
+        }
+        MergeJsonClassDefinitionObjects(MergedObjects->Values, MoveTemp((*Objects)->Values), JsonFileName);
+    }
+
+    for (const auto& [DumpName, Overlays] : OverlaysByDumpName)
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Base dump %s not found, %d overlays referencing it have not been applied"), *DumpName, Overlays.Num());
+    }
+
+    OutRootObject = MakeShared<FJsonObject>();
+    OutRootObject->SetObjectField(TEXT("objects"), MergedObjects);
+
+    // References between the dumps can only be followed once all of them are merged
+    if (ReachabilitySeedObjectPaths)
+    {
+        PruneUnreachableObjects(OutRootObject, *ReachabilitySeedObjectPaths);
+    }
+    return !MergedObjects->Values.IsEmpty();
+}
+
+FString FSuziePluginModule::GetDumpSnapshotFilePath()
+{
+    return (BenchmarkDumpDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("Suzie") : BenchmarkDumpDirectory) / TEXT("DumpSnapshot.bin");
+}
+
+FString FSuziePluginModule::GetBaseDumpSnapshotFilePath(const FString& JsonFileName)
+{
+    return (BenchmarkDumpDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("Suzie") : BenchmarkDumpDirectory) / TEXT("DumpSnapshots") / FPaths::GetCleanFilename(JsonFileName) + TEXT(".bin");
+}
+
+FSHAHash FSuziePluginModule::GetDumpFileContentHash(const FString& FilePath)
+{
+    if (const FSHAHash* ContentHash = DumpFileContentHashes.Find(FilePath))
+    {
+        return *ContentHash;
+    }
+
+    // Dumps are identified by their contents, since copying or checking out a dump does not necessarily change its size or modification time.
+    // Hashing the compressed files is still much cheaper than decompressing and parsing them
+    FSHA1 HashState;
+    const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (FileReader.IsValid())
+    {
+        TArray<uint8> FileChunk;
+        FileChunk.SetNumUninitialized(1024 * 1024);
+        const int64 FileSize = FileReader->TotalSize();
+        for (int64 Offset = 0; Offset < FileSize; Offset += FileChunk.Num())
+        {
+            const int64 ChunkSize = FMath::Min<int64>(FileChunk.Num(), FileSize - Offset);
+            FileReader->Serialize(FileChunk.GetData(), ChunkSize);
+            HashState.Update(FileChunk.GetData(), ChunkSize);
+        }
+    }
+    HashState.Final();
+    FSHAHash ContentHash;
+    HashState.GetHash(ContentHash.Hash);
+    DumpFileContentHashes.Add(FilePath, ContentHash);
+    return ContentHash;
+}
+
+FSHAHash FSuziePluginModule::ComputeBaseDumpSnapshotInputHash(const FString& FilePath)
+{
+    FSHA1 HashState;
+    auto UpdateHash = [&](const FString& String)
+    {
+        HashState.Update(reinterpret_cast<const uint8*>(*String), (String.Len() + 1) * sizeof(TCHAR));
+    };
+    UpdateHash(FEngineVersion::Current().ToString());
+    const FSHAHash ContentHash = GetDumpFileContentHash(FilePath);
+    HashState.Update(ContentHash.Hash, sizeof(ContentHash.Hash));
+
+    // Objects of skipped packages are left out while parsing, so they decide what the parsed dump contains as well
+    TArray<FString> SortedSkippedPackageNames = SkippedPackageNames.Array();
+    SortedSkippedPackageNames.Sort();
+    for (const FString& PackageName : SortedSkippedPackageNames)
+    {
+        UpdateHash(PackageName);
+    }
+
+    HashState.Final();
+    FSHAHash Hash;
+    HashState.GetHash(Hash.Hash);
+    return Hash;
+}
+
+bool FSuziePluginModule::LoadBaseJsonClassDefinitionFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutRootObject)
+{
+    if (!GetDefault<USuzieSettings>()->bUseDumpSnapshot)
+    {
+        return LoadJsonClassDefinitionFile(FilePath, OutRootObject, &SkippedPackageNames, &SkippedObjectPaths);
+    }
+
+    // Parsed base dumps are snapshotted on their own, so that changing an overlay only reparses the overlays and not the dumps they apply to
+    const FString SnapshotFilePath = GetBaseDumpSnapshotFilePath(FilePath);
+    const FSHAHash InputHash = ComputeBaseDumpSnapshotInputHash(FilePath);
+    TSet<FString> DumpSkippedObjectPaths;
+    if (!FSuzieDumpSnapshot::Load(SnapshotFilePath, InputHash, OutRootObject, DumpSkippedObjectPaths))
+    {
+        if (!LoadJsonClassDefinitionFile(FilePath, OutRootObject, &SkippedPackageNames, &DumpSkippedObjectPaths))
+        {
+            return false;
+        }
+        FSuzieDumpSnapshot::Save(SnapshotFilePath, InputHash, OutRootObject, DumpSkippedObjectPaths);
+    }
+    SkippedObjectPaths.Append(MoveTemp(DumpSkippedObjectPaths));
+    return true;
+}
+
+FSHAHash FSuziePluginModule::ComputeDumpSnapshotInputHash(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, const TSet<FString>* ReachabilitySeedObjectPaths)
+{
+    FSHA1 HashState;
+    auto UpdateHash = [&](const FString& String)
+    {
+        // Strings are terminated so that consecutive strings cannot be confused with each other
+        HashState.Update(reinterpret_cast<const uint8*>(*String), (String.Len() + 1) * sizeof(TCHAR));
+    };
+    UpdateHash(FEngineVersion::Current().ToString());
+
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+    for (const TArray<FString>* FileNames : {&DumpFileNames, &OverlayFileNames})
+    {
+        for (const FString& FileName : *FileNames)
+        {
+            UpdateHash(FileName);
+            const FSHAHash ContentHash = GetDumpFileContentHash(JsonClassesPath / FileName);
+            HashState.Update(ContentHash.Hash, sizeof(ContentHash.Hash));
+        }
+    }
+
+    // Skipped packages and reachable types decide which objects are in the merged dumps
+    TArray<FString> SortedSkippedPackageNames = SkippedPackageNames.Array();
+    SortedSkippedPackageNames.Sort();
+    for (const FString& PackageName : SortedSkippedPackageNames)
+    {
+        UpdateHash(PackageName);
+    }
+    if (ReachabilitySeedObjectPaths)
+    {
+        UpdateHash(TEXT("Reachable"));
+        for (const FString& AlwaysGeneratedType : GetDefault<USuzieSettings>()->AlwaysGeneratedTypes)
+        {
+            UpdateHash(AlwaysGeneratedType);
+        }
+        TArray<FString> SortedSeedObjectPaths = ReachabilitySeedObjectPaths->Array();
+        SortedSeedObjectPaths.Sort();
+        for (const FString& SeedObjectPath : SortedSeedObjectPaths)
+        {
+            UpdateHash(SeedObjectPath);
+        }
+    }
+
+    HashState.Final();
+    FSHAHash Hash;
+    HashState.GetHash(Hash.Hash);
+    return Hash;
+}
+
+FString FSuziePluginModule::GetGenerationProfileFilePath()
+{
+    return (BenchmarkDumpDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("Suzie") : BenchmarkDumpDirectory) / TEXT("GenerationProfile.json");
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::BenchmarkJsonClassDefinitions(const FString& DumpDirectory)
+{
+    TGuardValue<FString> DumpDirectoryGuard(BenchmarkDumpDirectory, FPaths::ConvertRelativePathToFull(DumpDirectory));
+
+    // Every type in the dumps is generated and every phase runs each time, so that runs are comparable no matter how the project is configured
+    USuzieSettings* Settings = GetMutableDefault<USuzieSettings>();
+    TGuardValue<bool> WriteGenerationProfileGuard(Settings->bWriteGenerationProfile, true);
+    TGuardValue<bool> UseDumpSnapshotGuard(Settings->bUseDumpSnapshot, false);
+    TGuardValue<bool> OnlyGenerateReachableTypesGuard(Settings->bOnlyGenerateReachableTypes, false);
+    TGuardValue<bool> StreamDumpsGuard(Settings->bStreamDumps, false);
+    TGuardValue<bool> SkipObjectsInNativePackagesGuard(Settings->bSkipObjectsInNativePackages, false);
+    TGuardValue<bool> DeferClassFunctionsGuard(Settings->bDeferClassFunctions, false);
+
+    UE_LOG(LogSuzie, Display, TEXT("Benchmarking generation from %s"), *BenchmarkDumpDirectory);
+    ProcessAllJsonClassDefinitions();
+    return FSuzieGenerationProfile::Load(GetGenerationProfileFilePath());
 }
 
 void FSuziePluginModule::ProcessAllJsonClassDefinitions()
 {
     
     // Define where we expect JSON class definitions to be
-    const FString JsonClassesPath = FPaths::ProjectContentDir() / TEXT("DynamicClasses");
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
     
     // Check if directory exists
     if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*JsonClassesPath))
@@ -51,91 +637,122 @@ void FSuziePluginModule::ProcessAllJsonClassDefinitions()
         UE_LOG(LogSuzie, Warning, TEXT("JSON Classes directory not found: %s"), *JsonClassesPath);
         return;
     }
+
+    const USuzieSettings* Settings = GetDefault<USuzieSettings>();
+    if (Settings->bWriteGenerationProfile)
+    {
+        GenerationProfile = MakeUnique<FSuzieGenerationProfile>();
+    }
     
     // Find all JSON files and compressed JSON files
     TArray<FString> JsonFileNames;
-    IFileManager::Get().FindFiles(JsonFileNames, *JsonClassesPath, TEXT("*.jmap"));
-
-    TArray<FString> CompressedJsonFileNames;
-    IFileManager::Get().FindFiles(CompressedJsonFileNames, *JsonClassesPath, TEXT("*.jmap.gz"));
+    TArray<FString> OverlayJsonFileNames;
+    {
+        FSuzieGenerationProfile::FScopedPhase FindFilesPhase(GenerationProfile.Get(), TEXT("FindFiles"));
+        FindJsonClassDefinitionFiles(JsonFileNames, OverlayJsonFileNames);
+    }
     
-    UE_LOG(LogSuzie, Display, TEXT("Found %d JSON class definition files"), JsonFileNames.Num() + CompressedJsonFileNames.Num());
+    UE_LOG(LogSuzie, Display, TEXT("Found %d JSON class definition files and %d overlays"), JsonFileNames.Num(), OverlayJsonFileNames.Num());
 
     // This can potentially take some time so show a progress task
-    const int32 TotalAmountOfWork = JsonFileNames.Num() + CompressedJsonFileNames.Num();
+    const int32 TotalAmountOfWork = JsonFileNames.Num() + 2;
     FScopedSlowTask GenerateDynamicClassesTask(TotalAmountOfWork, LOCTEXT("GeneratingDynamicClasses", "Suzie: Generating Dynamic Classes"));
     GenerateDynamicClassesTask.Visibility = ESlowTaskVisibility::ForceVisible;
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
     GenerateDynamicClassesTask.Visibility = ESlowTaskVisibility::Important;
     GenerateDynamicClassesTask.ForceRefresh();
 #endif
-    
-    // Process each JSON file
-    for (const FString& JsonFileName : JsonFileNames)
+
+    GenerateAllJsonClassDefinitions(JsonFileNames, OverlayJsonFileNames, GenerateDynamicClassesTask);
+
+    // Compare against the previous run before it is overwritten, so that slowdowns from new dumps or engine upgrades are noticed
+    if (GenerationProfile.IsValid())
     {
-        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingJsonFile", "Generating classes for file {0}"), FText::AsCultureInvariant(JsonFileName)));
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
-        GenerateDynamicClassesTask.ForceRefresh();
-#endif
-        UE_LOG(LogSuzie, Display, TEXT("Processing JSON class definition: %s"), *JsonFileName);
-    
-        // Read the JSON file
-        FString JsonContent;
-        if (!FFileHelper::LoadFileToString(JsonContent, *(JsonClassesPath / JsonFileName)))
-        {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to read JSON file: %s"), *JsonFileName);
-            return;
-        }
-    
-        // Parse the JSON
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonContent);
-        if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+        const FString ProfileFilePath = GetGenerationProfileFilePath();
+        // Benchmarks are compared against their own baseline by the caller, and the project budgets do not apply to synthetic dumps
+        if (BenchmarkDumpDirectory.IsEmpty())
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to parse JSON in file: %s"), *JsonFileName);
-            continue;
+            const TSharedPtr<FJsonObject> PreviousProfile = FSuzieGenerationProfile::Load(ProfileFilePath);
+            GenerationProfile->CheckBudgets(PreviousProfile, Settings->GenerationPhaseBudgets, Settings->GenerationRegressionThresholdPercent, IsRunningCommandlet());
         }
-        CreateDynamicClassesForJsonObject(JsonObject);
+        GenerationProfile->Save(ProfileFilePath, Settings->NumProfiledMostExpensiveTypes);
+        GenerationProfile.Reset();
     }
-    
-    // Process each compressed JSON file
-    for (const FString& CompressedJsonFileName : CompressedJsonFileNames)
+}
+
+void FSuziePluginModule::GenerateAllJsonClassDefinitions(const TArray<FString>& JsonFileNames, const TArray<FString>& OverlayJsonFileNames, FScopedSlowTask& GenerateDynamicClassesTask)
+{
+    // Decide which packages do not need to be parsed at all before loading anything
+    GatherSkippedPackageNames();
+    DumpFileContentHashes.Reset();
+
+    // Huge dumps can be generated from without ever holding all of their definitions in memory
+    if (GetDefault<USuzieSettings>()->bStreamDumps)
     {
-        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingJsonFile", "Generating classes for file {0}"), FText::AsCultureInvariant(CompressedJsonFileName)));
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
-        GenerateDynamicClassesTask.ForceRefresh();
-#endif
-        UE_LOG(LogSuzie, Display, TEXT("Processing compressed JSON class definition: %s"), *CompressedJsonFileName);
+        CreateDynamicClassesFromStreamedDumps(JsonFileNames, OverlayJsonFileNames, GenerateDynamicClassesTask);
+        return;
+    }
 
-        // Read binary file contents
-        TArray<uint8> CompressedFileContents;
-        if (!FFileHelper::LoadFileToArray(CompressedFileContents, *(JsonClassesPath / CompressedJsonFileName)))
+    // Reuse the merged dumps of the last startup if nothing they have been created from has changed. Shards of sharded dumps are loaded
+    // on demand during generation, which needs the shard index, so sharded dumps are always loaded from the dumps
+    TSharedPtr<FJsonObject> MergedRootObject;
+    const bool bUseDumpSnapshot = GetDefault<USuzieSettings>()->bUseDumpSnapshot && !JsonFileNames.ContainsByPredicate(&IsJsonClassDefinitionShardIndexFile);
+
+    // Gathering the seeds scans the project content synchronously, so it is done once for both the snapshot and the dumps
+    TSet<FString> ReachabilitySeedObjectPaths;
+    const bool bOnlyGenerateReachableTypes = GetDefault<USuzieSettings>()->bOnlyGenerateReachableTypes;
+    if (bOnlyGenerateReachableTypes)
+    {
+        GatherReachableTypeSeeds(ReachabilitySeedObjectPaths);
+    }
+    FSHAHash DumpSnapshotInputHash;
+    if (bUseDumpSnapshot)
+    {
+        FSuzieGenerationProfile::FScopedPhase LoadSnapshotPhase(GenerationProfile.Get(), TEXT("LoadSnapshot"));
+        const double SnapshotLoadStartTime = FPlatformTime::Seconds();
+        DumpSnapshotInputHash = ComputeDumpSnapshotInputHash(JsonFileNames, OverlayJsonFileNames, bOnlyGenerateReachableTypes ? &ReachabilitySeedObjectPaths : nullptr);
+        if (FSuzieDumpSnapshot::Load(GetDumpSnapshotFilePath(), DumpSnapshotInputHash, MergedRootObject, SkippedObjectPaths))
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to read compressed JSON file: %s"), *CompressedJsonFileName);
-            return;
+            UE_LOG(LogSuzie, Display, TEXT("Loaded merged dumps from snapshot in %.2f seconds"), FPlatformTime::Seconds() - SnapshotLoadStartTime);
         }
+    }
 
-        // Attempt to decompress the file as Gzip archive
-        TArray<uint8> DecompressedFileContents;
-        if (!FSuzieDecompressionHelper::DecompressMemoryGzip(CompressedFileContents, DecompressedFileContents))
+    // All dumps are merged into a single index first, so that types can reference types from other dumps and types present in multiple dumps are generated once
+    if (!MergedRootObject.IsValid())
+    {
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to decompress compressed JSON file as valid GZIP: %s"), *CompressedJsonFileName);
-            return;
+            FSuzieGenerationProfile::FScopedPhase LoadDumpsPhase(GenerationProfile.Get(), TEXT("LoadDumps"));
+            if (!LoadMergedJsonClassDefinitions(JsonFileNames, OverlayJsonFileNames, bOnlyGenerateReachableTypes ? &ReachabilitySeedObjectPaths : nullptr, MergedRootObject, GenerateDynamicClassesTask))
+            {
+                return;
+            }
         }
-
-        // Parse the binary stream into the string. UE will attempt to guess the encoding for us
-        FString JsonContent;
-        FFileHelper::BufferToString(JsonContent, DecompressedFileContents.GetData(), DecompressedFileContents.Num());
-        
-        // Parse the JSON
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonContent);
-        if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+        if (bUseDumpSnapshot)
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to parse compressed JSON in file: %s"), *CompressedJsonFileName);
-            continue;
+            FSuzieGenerationProfile::FScopedPhase SaveSnapshotPhase(GenerationProfile.Get(), TEXT("SaveSnapshot"));
+            FSuzieDumpSnapshot::Save(GetDumpSnapshotFilePath(), DumpSnapshotInputHash, MergedRootObject, SkippedObjectPaths);
         }
-        CreateDynamicClassesForJsonObject(JsonObject);
+    }
+
+    GenerateDynamicClassesTask.EnterProgressFrame(1, LOCTEXT("GeneratingClasses", "Generating classes"));
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
+    GenerateDynamicClassesTask.ForceRefresh();
+#endif
+    CreateDynamicClassesForJsonObject(MergedRootObject);
+
+    // Types generated from the shards loaded on demand have to be known to hot reload as well
+    if (OnDemandShardObjects.IsValid())
+    {
+        MergedRootObject->GetObjectField(TEXT("objects"))->Values.Append(OnDemandShardObjects->Values);
+    }
+
+    // Remember what the types have been generated from so that we can tell what has changed when the dumps are modified
+    // Type hashes are only needed to diff the dumps when they change, so do not waste time computing them otherwise
+    const TSharedPtr<FJsonObject>* Objects;
+    if (GIsEditor && !IsRunningCommandlet() && GetDefault<USuzieSettings>()->bHotReloadChangedDumps && MergedRootObject->TryGetObjectField(TEXT("objects"), Objects))
+    {
+        FSuzieGenerationProfile::FScopedPhase ComputeTypeHashesPhase(GenerationProfile.Get(), TEXT("ComputeTypeHashes"));
+        ComputeTypeDefinitionHashes(*Objects, GeneratedTypeHashes);
     }
 }
 
@@ -151,61 +768,94 @@ void FSuziePluginModule::CreateDynamicClassesForJsonObject(const TSharedPtr<FJso
     // Create class generation context
     FDynamicClassGenerationContext ClassGenerationContext;
     ClassGenerationContext.GlobalObjectMap = *Objects;
+    ClassGenerationContext.SkippedObjectPaths = &SkippedObjectPaths;
+    SetupOnDemandObjectDefinitions(ClassGenerationContext);
+    // Commandlets need all functions right away, and there is no idle time to create them in
+    ClassGenerationContext.bDeferClassFunctions = GetDefault<USuzieSettings>()->bDeferClassFunctions && GIsEditor && !IsRunningCommandlet();
 
     // Create classes, script structs and global delegate functions
-    for (auto It = (*Objects)->Values.CreateConstIterator(); It; ++It)
-    {
-        FString ObjectPath = It.Key();
-        FString Type = It.Value()->AsObject()->GetStringField(TEXT("type"));
-        if (Type == TEXT("Class"))
-        {
-            // Meatloaf bug (commit d8179e8): CDOs of UClass-derived native classes will be labeled with Class type, instead of "Object" type, which will result in a crash
-            // down the line due to the CDO being created with the wrong class type
-            FString PackageName;
-            FString ClassName;
-            ParseObjectPath(ObjectPath, PackageName, ClassName);
-            if (ClassName.StartsWith(TEXT("Default__")))
-            {
-                continue;
-            }
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating class %s"), *ObjectPath);
-            FindOrCreateClass(ClassGenerationContext, ObjectPath);
-        }
-        else if (Type == TEXT("ScriptStruct"))
-        {
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating struct %s"), *ObjectPath);
-            FindOrCreateScriptStruct(ClassGenerationContext, ObjectPath);
-        }
-        else if (Type == TEXT("Enum"))
+    {
+        FSuzieGenerationProfile::FScopedPhase CreateTypesPhase(GenerationProfile.Get(), TEXT("CreateTypes"));
+        SUZIE_TRACE_SCOPE(CreateTypes);
+        SUZIE_TRACE_PHASE_MEMORY_SCOPE(SuzieGenerationPhaseMemory);
+        for (auto It = (*Objects)->Values.CreateConstIterator(); It; ++It)
         {
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating enum %s"), *ObjectPath);
-            FindOrCreateEnum(ClassGenerationContext, ObjectPath);
+            CreateDynamicTypeForObject(ClassGenerationContext, It.Key(), It.Value()->AsObject());
         }
-        else if (Type == TEXT("Function"))
+    }
+    FinishCreatingDynamicClasses(ClassGenerationContext, *Objects);
+}
+
+void FSuziePluginModule::CreateDynamicTypeForObject(FDynamicClassGenerationContext& Context, const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition)
+{
+    const FString Type = ObjectDefinition->GetStringField(TEXT("type"));
+    if (GenerationProfile.IsValid())
+    {
+        GenerationProfile->CountObject(Type);
+    }
+    if (Type == TEXT("Class"))
+    {
+        // Meatloaf bug (commit d8179e8): CDOs of UClass-derived native classes will be labeled with Class type, instead of "Object" type, which will result in a crash
+        // down the line due to the CDO being created with the wrong class type
+        FString PackageName;
+        FString ClassName;
+        ParseObjectPath(ObjectPath, PackageName, ClassName);
+        if (ClassName.StartsWith(TEXT("Default__")))
         {
-            UE_LOG(LogSuzie, VeryVerbose, TEXT("Creating function %s"), *ObjectPath);
-            FindOrCreateFunction(ClassGenerationContext, ObjectPath);
+            return;
         }
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating class %s"), *ObjectPath);
+        FindOrCreateClass(Context, ObjectPath);
+    }
+    else if (Type == TEXT("ScriptStruct"))
+    {
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating struct %s"), *ObjectPath);
+        FindOrCreateScriptStruct(Context, ObjectPath);
+    }
+    else if (Type == TEXT("Enum"))
+    {
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating enum %s"), *ObjectPath);
+        FindOrCreateEnum(Context, ObjectPath);
+    }
+    else if (Type == TEXT("Function"))
+    {
+        UE_LOG(LogSuzie, VeryVerbose, TEXT("Creating function %s"), *ObjectPath);
+        FindOrCreateFunction(Context, ObjectPath);
     }
+}
 
+void FSuziePluginModule::FinishCreatingDynamicClasses(FDynamicClassGenerationContext& Context, const TSharedPtr<FJsonObject>& Objects)
+{
+    FSuzieGenerationProfile::FScopedPhase FinishCreatingTypesPhase(GenerationProfile.Get(), TEXT("FinishCreatingTypes"));
+    SUZIE_TRACE_SCOPE(FinishCreatingTypes);
+    SUZIE_TRACE_PHASE_MEMORY_SCOPE(SuzieFinalizationPhaseMemory);
     // Construct classes that have been created but have not been constructed yet due to nobody referencing them
-    while (!ClassGenerationContext.ClassesPendingConstruction.IsEmpty())
+    while (!Context.ClassesPendingConstruction.IsEmpty())
     {
         TArray<FString> ClassPathsPendingConstruction;
-        ClassGenerationContext.ClassesPendingConstruction.GenerateValueArray(ClassPathsPendingConstruction);
+        Context.ClassesPendingConstruction.GenerateValueArray(ClassPathsPendingConstruction);
         for (const FString& ClassPath : ClassPathsPendingConstruction)
         {
-            FindOrCreateClass(ClassGenerationContext, ClassPath);
+            FindOrCreateClass(Context, ClassPath);
         }
     }
 
     // Finalize all classes that we have created now. This includes assembling reference streams, creating default subobjects and populating them with data
     TArray<UClass*> ClassesPendingFinalization;
-    ClassGenerationContext.ClassesPendingFinalization.GenerateKeyArray(ClassesPendingFinalization);
+    Context.ClassesPendingFinalization.GenerateKeyArray(ClassesPendingFinalization);
     for (UClass* ClassPendingFinalization : ClassesPendingFinalization)
     {
-        FinalizeClass(ClassGenerationContext, ClassPendingFinalization);
+        FinalizeClass(Context, ClassPendingFinalization);
+    }
+
+    FlushPendingMetaData(Context);
+
+    if (!DeferredClassFunctions.IsEmpty())
+    {
+        BeginMaterializingDeferredFunctions(Objects);
     }
+
+    UE_LOG(LogSuzie, Verbose, TEXT("%d properties have been duplicated from a prototype, %d property prototypes exist"), Context.NumPropertiesFromPrototypes, PropertyPrototypes.Num());
 }
 
 UPackage* FSuziePluginModule::FindOrCreatePackage(FDynamicClassGenerationContext& Context, const FString& PackageName)
@@ -216,6 +866,7 @@ UPackage* FSuziePluginModule::FindOrCreatePackage(FDynamicClassGenerationContext
     
     UPackage* Package = CreatePackage(*PackageName);
     Package->SetPackageFlags(PKG_CompiledIn);
+    DynamicPackageNames.Add(Package->GetFName());
     return Package;
 }
 
@@ -224,7 +875,8 @@ UClass* FSuziePluginModule::GetPlaceholderNonNativePropertyOwnerClass()
     static UBlueprintGeneratedClass* PlaceholderNonNativeOwnerClass = nullptr;
     if (PlaceholderNonNativeOwnerClass == nullptr)
     {
-        PlaceholderNonNativeOwnerClass = NewObject<UBlueprintGeneratedClass>(GetTransientPackage(), TEXT("SuziePlaceholderBlueprintClass"), RF_Public | RF_Transient | RF_MarkAsRootSet);
+        PlaceholderNonNativeOwnerClass = NewObject<UBlueprintGeneratedClass>(GetTransientPackage(), TEXT("SuziePlaceholderBlueprintClass"), RF_Public | RF_Transient);
+        KeepGeneratedObjectAlive(PlaceholderNonNativeOwnerClass);
         PlaceholderNonNativeOwnerClass->SetSuperStruct(UObject::StaticClass());
         PlaceholderNonNativeOwnerClass->ClassFlags = CLASS_Abstract | CLASS_Hidden | CLASS_Transient;
 
@@ -237,10 +889,16 @@ UClass* FSuziePluginModule::GetPlaceholderNonNativePropertyOwnerClass()
 UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGenerationContext& Context, const FString& ClassPath)
 {
     // Attempt to find an existing class first
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     if (UClass* ExistingClass = FindObject<UClass>(nullptr, *ClassPath))
     {
         return ExistingClass;
     }
+    // Objects in native packages are not parsed, so there is nothing to create this object from if it does not exist in the editor
+    if (IsObjectSkippedDuringParse(Context, ClassPath))
+    {
+        return nullptr;
+    }
     // We need to handle this case here because of the possibility of native class having a function that requries a child class as an argument
     if (Context.UnregisteredDynamicClassConstructionStack.Contains(ClassPath))
     {
@@ -249,7 +907,7 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
     }
     Context.UnregisteredDynamicClassConstructionStack.Add(ClassPath);
     
-    const TSharedPtr<FJsonObject> ClassDefinition = Context.GlobalObjectMap->GetObjectField(ClassPath);
+    const TSharedPtr<FJsonObject> ClassDefinition = FindObjectDefinition(Context, ClassPath);
     checkf(ClassDefinition.IsValid(), TEXT("Failed to find class object by path %s"), *ClassPath);
     
     const FString ObjectType = ClassDefinition->GetStringField(TEXT("type"));
@@ -309,7 +967,7 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
         ClassFlags,
         CASTCLASS_None,
         UObject::StaticConfigName(),
-        RF_Public | RF_MarkAsNative | RF_MarkAsRootSet,
+        RF_Public | RF_MarkAsNative,
         &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper,
         ParentClass->ClassVTableHelperCtorCaller,
         MoveTemp(ClassStaticFunctions));
@@ -329,6 +987,7 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
     //Register pending object, apply class flags, set static type info and link it
     ConstructedClassObject->RegisterDependencies();
     ConstructedClassObject->DeferredRegister(UClass::StaticClass(), *PackageName, *ClassName);
+    KeepGeneratedObjectAlive(ConstructedClassObject);
 
     Context.ClassesPendingConstruction.Add(ConstructedClassObject, ClassPath);
     Context.UnregisteredDynamicClassConstructionStack.Remove(ClassPath);
@@ -348,14 +1007,117 @@ public:
     }
 };
 
+// Returns true if both property descriptors are bitfield bools sharing the same storage in the dumped type
+static bool SharesBitfieldStorage(const TSharedPtr<FJsonObject>& PreviousPropertyJson, const TSharedPtr<FJsonObject>& PropertyJson)
+{
+    int32 PreviousFieldSize, PreviousByteOffset, PreviousFieldMask;
+    int32 FieldSize, ByteOffset, FieldMask;
+    if (!PreviousPropertyJson->TryGetNumberField(TEXT("field_size"), PreviousFieldSize) || !PreviousPropertyJson->TryGetNumberField(TEXT("byte_offset"), PreviousByteOffset) ||
+        !PreviousPropertyJson->TryGetNumberField(TEXT("field_mask"), PreviousFieldMask) || !PropertyJson->TryGetNumberField(TEXT("field_size"), FieldSize) ||
+        !PropertyJson->TryGetNumberField(TEXT("byte_offset"), ByteOffset) || !PropertyJson->TryGetNumberField(TEXT("field_mask"), FieldMask))
+    {
+        return false;
+    }
+    // Native bools occupy their entire field
+    if (PreviousFieldMask == 0xFF || FieldMask == 0xFF || PreviousFieldSize != FieldSize)
+    {
+        return false;
+    }
+    // When the dump has property offsets, bitfields sharing the storage have the same offset
+    int32 PreviousOffset, Offset;
+    if (PreviousPropertyJson->TryGetNumberField(TEXT("offset"), PreviousOffset) && PropertyJson->TryGetNumberField(TEXT("offset"), Offset))
+    {
+        return PreviousOffset == Offset;
+    }
+    // Otherwise consecutive bitfields in the same storage occupy increasing bits, and a new storage starts from the lowest bit again
+    return ByteOffset * 8 + FMath::FloorLog2(FieldMask) > PreviousByteOffset * 8 + FMath::FloorLog2(PreviousFieldMask);
+}
+
+// Lays out the properties of the struct again, placing the bitfield bools that share their storage in the dump into the same bytes.
+// Offsets of the properties not following a bitfield are computed the same way as UStruct::Link does, starting from the offset of the first property
+static void PackBitfieldBoolProperties(UStruct* Struct, const TArray<TSharedPtr<FJsonValue>>& PropertyDescriptors)
+{
+    TMap<FName, TSharedPtr<FJsonObject>> PropertyDescriptorsByName;
+    for (const TSharedPtr<FJsonValue>& PropertyDescriptor : PropertyDescriptors)
+    {
+        const TSharedPtr<FJsonObject> PropertyJson = PropertyDescriptor->AsObject();
+        PropertyDescriptorsByName.Add(FName(*PropertyJson->GetStringField(TEXT("name"))), PropertyJson);
+    }
+
+    TOptional<int32> CurrentPropertiesSize;
+    const FBoolProperty* PreviousBoolProperty = nullptr;
+    TSharedPtr<FJsonObject> PreviousPropertyJson;
+    bool bPackedAnyProperties = false;
+    for (FField* Field = Struct->ChildProperties; Field; Field = Field->Next)
+    {
+        FProperty* Property = CastField<FProperty>(Field);
+        if (Property == nullptr)
+        {
+            continue;
+        }
+        const TSharedPtr<FJsonObject>* PropertyJson = PropertyDescriptorsByName.Find(Property->GetFName());
+        if (!CurrentPropertiesSize.IsSet())
+        {
+            CurrentPropertiesSize = Property->GetOffset_ForInternal();
+        }
+
+        if (PreviousBoolProperty && PreviousPropertyJson && PropertyJson && Property->IsA<FBoolProperty>() && SharesBitfieldStorage(PreviousPropertyJson, *PropertyJson))
+        {
+            FPropertyAccessor::SetPropertyOffsetDirect(Property, PreviousBoolProperty->GetOffset_ForInternal());
+            bPackedAnyProperties = true;
+        }
+        else
+        {
+            const int32 PropertyOffset = Align(CurrentPropertiesSize.GetValue(), Property->GetMinAlignment());
+            FPropertyAccessor::SetPropertyOffsetDirect(Property, PropertyOffset);
+            CurrentPropertiesSize = PropertyOffset + Property->GetSize();
+        }
+        PreviousBoolProperty = CastField<FBoolProperty>(Property);
+        PreviousPropertyJson = PropertyJson ? *PropertyJson : nullptr;
+    }
+
+    // Sizes only need to be updated when something has been packed, otherwise the layout is identical to the original one
+    if (bPackedAnyProperties)
+    {
+        Struct->SetPropertiesSize(CurrentPropertiesSize.GetValue());
+    }
+}
+
+// Returns true if the property value is all zeroes after construction, false if it needs its constructor called
+static bool IsZeroConstructedProperty(const FProperty* Property)
+{
+    // Bitfield bools are not zero constructible on their own because their storage is shared, but the storage belongs to the same struct or class
+    return Property->HasAnyPropertyFlags(CPF_ZeroConstructor) || Property->IsA<FBoolProperty>();
+}
+
+// Structs without native struct ops only get the trivial struct flags when all of their properties have the matching property flags, which bitfield bools never have.
+// Containers and struct properties of trivial structs are constructed, copied and destroyed in bulk, so this marks the structs that are trivial despite their bools
+static void MarkTrivialScriptStruct(UScriptStruct* Struct)
+{
+    bool bZeroConstructor = true;
+    bool bPlainOldData = true;
+    bool bNoDestructor = true;
+    for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+    {
+        const bool bIsBoolProperty = Property->IsA<FBoolProperty>();
+        bZeroConstructor &= IsZeroConstructedProperty(Property);
+        bPlainOldData &= bIsBoolProperty || Property->HasAnyPropertyFlags(CPF_IsPlainOldData);
+        bNoDestructor &= bIsBoolProperty || Property->HasAnyPropertyFlags(CPF_IsPlainOldData | CPF_NoDestructor);
+    }
+    Struct->StructFlags = (EStructFlags)((int32)Struct->StructFlags | (bZeroConstructor ? STRUCT_ZeroConstructor : 0) |
+        (bPlainOldData ? STRUCT_IsPlainOldData : 0) | (bNoDestructor ? STRUCT_NoDestructor : 0));
+}
+
 // Internal property type injected into DestructorLink of dynamic classes to force the destruction of their properties (despite the class being marked as native)
 class FDynamicClassDestructorCallProperty : public FProperty
 {
     TArray<const FProperty*> PropertiesToDestroy;
+    TSharedPtr<FSuzieClassConstructionStats> ConstructionStats;
 public:
-    explicit FDynamicClassDestructorCallProperty(UClass* InOwner, const TArray<const FProperty*>& InPropertiesToDestroy) :
+    explicit FDynamicClassDestructorCallProperty(UClass* InOwner, const TArray<const FProperty*>& InPropertiesToDestroy, const TSharedPtr<FSuzieClassConstructionStats>& InConstructionStats) :
         FProperty(InOwner, TEXT("DynamicClassDestructorCall"), RF_Public),
-        PropertiesToDestroy(InPropertiesToDestroy)
+        PropertiesToDestroy(InPropertiesToDestroy),
+        ConstructionStats(InConstructionStats)
     {
         PropertyFlags |= CPF_ZeroConstructor;
 #if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5)
@@ -376,6 +1138,9 @@ public:
     virtual void FinishDestroyInternal(void* Data) const override
     {
         checkf(GetOffset_ForInternal() == 0, TEXT("Dynamic class destructor call property expected to be at offset 0 in the class"));
+        SCOPE_CYCLE_COUNTER(STAT_SuzieDynamicObjectDestruction);
+        INC_DWORD_STAT(STAT_SuzieDynamicObjectsDestroyed);
+        FSuzieConstructionStats::FScopedDestruction DestructionStatsScope(ConstructionStats.Get());
         for (const FProperty* Property : PropertiesToDestroy)
         {
             Property->DestroyValue_InContainer(Data);
@@ -387,6 +1152,9 @@ public:
     virtual void DestroyValueInternal(void* Dest) const override
     {
         checkf(GetOffset_ForInternal() == 0, TEXT("Dynamic class destructor call property expected to be at offset 0 in the class"));
+        SCOPE_CYCLE_COUNTER(STAT_SuzieDynamicObjectDestruction);
+        INC_DWORD_STAT(STAT_SuzieDynamicObjectsDestroyed);
+        FSuzieConstructionStats::FScopedDestruction DestructionStatsScope(ConstructionStats.Get());
         for (const FProperty* Property : PropertiesToDestroy)
         {
             Property->DestroyValue_InContainer(Dest);
@@ -395,13 +1163,14 @@ public:
 #endif
 };
 
-// Note that new objects can be created from other threads, but we only touch this map when creating dynamic classes,
-// so we do not need an explicit mutex to guard the access to it during class initialization
-static TMap<UClass*, FDynamicClassConstructionData> DynamicClassConstructionData;
+TMap<UClass*, FDynamicClassConstructionData> FSuziePluginModule::DynamicClassConstructionData;
+TUniquePtr<FSuzieGeneratedObjectReferencer> FSuziePluginModule::GeneratedObjectReferencer;
+FString FSuziePluginModule::BenchmarkDumpDirectory;
 
 UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Context, const FString& ClassPath)
 {
     // Return existing class if exists
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     UClass* NewClass = FindObject<UClass>(nullptr, *ClassPath);
 
     // If class already exists and is not pending constructed, we do not need to do anything
@@ -410,9 +1179,13 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
         return NewClass;
     }
 
+    SUZIE_TRACE_SCOPE_TEXT(*ClassPath);
+    FSuzieGenerationProfile::FScopedType ProfileType(GenerationProfile.Get(), ClassPath);
+
     // If we have not created the class yet, create it now
     if (NewClass == nullptr)
     {
+        SUZIE_TRACE_COUNTER_INCREMENT(SuzieClassesCreated);
         NewClass = FindOrCreateUnregisteredClass(Context, ClassPath);
         if (NewClass == nullptr)
         {
@@ -424,18 +1197,19 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
     // Remove the class from the pending construction set to prevent possible re-entry
     Context.ClassesPendingConstruction.Remove(NewClass);
 
-    const TSharedPtr<FJsonObject> ClassDefinition = Context.GlobalObjectMap->GetObjectField(ClassPath);
+    const TSharedPtr<FJsonObject> ClassDefinition = FindObjectDefinition(Context, ClassPath);
 
     TArray<const FProperty*> PropertiesWithDestructor;
     TArray<const FProperty*> PropertiesWithConstructor;
     FArchive EmptyPropertyLinkArchive;
 
     // Add properties to the class
+    const FSuzieBlueprintExposureRule BlueprintExposure = GetBlueprintExposure(NewClass);
     const TArray<TSharedPtr<FJsonValue>>& Properties = ClassDefinition->GetArrayField(TEXT("properties"));
     for (const TSharedPtr<FJsonValue>& PropertyDescriptor : Properties)
     {
-        // We want all properties to be editable, visible and blueprint assignable
-        const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
+        // We want all properties to be editable, visible and blueprint assignable, unless the class is configured to hide them
+        const EPropertyFlags ExtraPropertyFlags = BlueprintExposure.bExposeProperties ? CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable : CPF_None;
         if (FProperty* CreatedProperty = AddPropertyToStruct(Context, NewClass, PropertyDescriptor->AsObject(), ExtraPropertyFlags))
         {
             // Because this is a native class, we have to link the property offset manually here rather than expecting StaticLink to do it for us
@@ -451,7 +1225,7 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
             {
                 PropertiesWithDestructor.Add(CreatedProperty);
             }
-            if (!CreatedProperty->HasAnyPropertyFlags(CPF_ZeroConstructor))
+            if (!IsZeroConstructedProperty(CreatedProperty))
             {
                 PropertiesWithConstructor.Add(CreatedProperty);
             }
@@ -463,39 +1237,54 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
     for (const TSharedPtr<FJsonValue>& FunctionObjectPathValue : Children)
     {
         FString ChildPath = FunctionObjectPathValue->AsString();
-        const TSharedPtr<FJsonObject> ChildObject = Context.GlobalObjectMap->GetObjectField(ChildPath);
+        const TSharedPtr<FJsonObject> ChildObject = FindObjectDefinition(Context, ChildPath);
         if (ChildObject && ChildObject->GetStringField(TEXT("type")) == TEXT("Function"))
         {
-            AddFunctionToClass(Context, NewClass, ChildPath);
+            if (Context.bDeferClassFunctions)
+            {
+                DeferredClassFunctions.FindOrAdd(NewClass).Add(ChildPath);
+            }
+            else
+            {
+                AddFunctionToClass(Context, NewClass, ChildPath);
+            }
         }
     }
 
     // Mark all dynamic classes as blueprintable and blueprint types, otherwise we will not be able to use them
-    NewClass->SetMetaData(FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
-    NewClass->SetMetaData(FBlueprintMetadata::MD_IsBlueprintBase, TEXT("true"));
-
-    if (NewClass->IsChildOf<UActorComponent>())
+    if (BlueprintExposure.bExposeTypes)
     {
-        NewClass->SetMetaData(FBlueprintMetadata::MD_BlueprintSpawnableComponent, TEXT("true"));
+        AddPendingMetaData(Context, NewClass, FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
+        AddPendingMetaData(Context, NewClass, FBlueprintMetadata::MD_IsBlueprintBase, TEXT("true"));
+
+        if (NewClass->IsChildOf<UActorComponent>())
+        {
+            AddPendingMetaData(Context, NewClass, FBlueprintMetadata::MD_BlueprintSpawnableComponent, TEXT("true"));
+        }
     }
 
+    // Classes are laid out one property at a time above, so bitfields still occupy separate bytes at this point
+    PackBitfieldBoolProperties(NewClass, Properties);
+
     // Bind parent class to this class and link properties to calculate their runtime derived data
     NewClass->Bind();
     NewClass->StaticLink();
     NewClass->SetSparseClassDataStruct(NewClass->GetSparseClassDataArchetypeStruct());
 
+    // Stash the properties that need to be constructed on the class data so polymorphic constructor can access them easily
+    FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindOrAdd(NewClass);
+    ClassConstructionData.PropertiesToConstruct = PropertiesWithConstructor;
+    ClassConstructionData.ConstructionStats = FSuzieConstructionStats::FindOrAddClassStats(ClassPath);
+
     // If we have properties that need destructor call, we add a synthetic property of custom type to DestructorLink
+    // Destruction of classes without such properties is not measured, since none of their destruction cost comes from the dynamic class
     if (!PropertiesWithDestructor.IsEmpty())
     {
-        FProperty* DestructorCallProperty = new FDynamicClassDestructorCallProperty(NewClass, PropertiesWithDestructor);
+        FProperty* DestructorCallProperty = new FDynamicClassDestructorCallProperty(NewClass, PropertiesWithDestructor, ClassConstructionData.ConstructionStats);
         DestructorCallProperty->DestructorLinkNext = NewClass->DestructorLink;
         NewClass->DestructorLink = DestructorCallProperty;
     }
 
-    // Stash the properties that need to be constructed on the class data so polymorphic constructor can access them easily
-    FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindOrAdd(NewClass);
-    ClassConstructionData.PropertiesToConstruct = PropertiesWithConstructor;
-
     const FString ClassDefaultObjectPath = ClassDefinition->GetStringField(TEXT("class_default_object"));
     
     // Class default object can be created at this point
@@ -507,12 +1296,21 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
 UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerationContext& Context, const FString& StructPath)
 {
     // Check if we have already created this struct
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     if (UScriptStruct* ExistingScriptStruct = FindObject<UScriptStruct>(nullptr, *StructPath))
     {
         return ExistingScriptStruct;
     }
+    // Objects in native packages are not parsed, so there is nothing to create this object from if it does not exist in the editor
+    if (IsObjectSkippedDuringParse(Context, StructPath))
+    {
+        return nullptr;
+    }
 
-    const TSharedPtr<FJsonObject> StructDefinition = Context.GlobalObjectMap->GetObjectField(StructPath);
+    SUZIE_TRACE_SCOPE_TEXT(*StructPath);
+    FSuzieGenerationProfile::FScopedType ProfileType(GenerationProfile.Get(), StructPath);
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieStructsCreated);
+    const TSharedPtr<FJsonObject> StructDefinition = FindObjectDefinition(Context, StructPath);
     checkf(StructDefinition.IsValid(), TEXT("Failed to find script struct object by path %s"), *StructPath);
     
     const FString ObjectType = StructDefinition->GetStringField(TEXT("type"));
@@ -538,7 +1336,8 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
     // Create a package for the struct or reuse the existing package. Make sure it's marked as Native package
     UPackage* Package = FindOrCreatePackage(Context, PackageName);
     
-    UScriptStruct* NewStruct = NewObject<UScriptStruct>(Package, *ObjectName, RF_Public | RF_MarkAsRootSet);
+    UScriptStruct* NewStruct = NewObject<UScriptStruct>(Package, *ObjectName, RF_Public);
+    KeepGeneratedObjectAlive(NewStruct);
 
     // Set super script struct and copy inheritable flags first if this struct has a parent (most structs do not)
     if (SuperScriptStruct != nullptr)
@@ -564,22 +1363,30 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
     }
 
     // Initialize properties for the struct
+    const FSuzieBlueprintExposureRule BlueprintExposure = GetBlueprintExposure(NewStruct);
     TArray<TSharedPtr<FJsonValue>> Properties = StructDefinition->GetArrayField(TEXT("properties"));
     for (const TSharedPtr<FJsonValue>& PropertyDescriptor : Properties)
     {
-        // We want all properties to be editable, visible and blueprint assignable
-        const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
+        // We want all properties to be editable, visible and blueprint assignable, unless the struct is configured to hide them
+        const EPropertyFlags ExtraPropertyFlags = BlueprintExposure.bExposeProperties ? CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable : CPF_None;
         AddPropertyToStruct(Context, NewStruct, PropertyDescriptor->AsObject(), ExtraPropertyFlags);
     }
     
     // Mark all dynamic script structs as blueprint types
-    NewStruct->SetMetaData(FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
+    if (BlueprintExposure.bExposeTypes)
+    {
+        AddPendingMetaData(Context, NewStruct, FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
+    }
 
     // Bind the newly created struct and link it to assign property offsets and calculate the size
     NewStruct->Bind();
     NewStruct->PrepareCppStructOps();
     NewStruct->StaticLink(true);
 
+    // StaticLink gives every property its own storage, including bitfields
+    PackBitfieldBoolProperties(NewStruct, Properties);
+    MarkTrivialScriptStruct(NewStruct);
+
     // The engine does not gracefully handle empty structs, so force the struct size to be at least one byte
     if (NewStruct->GetPropertiesSize() == 0)
     {
@@ -596,12 +1403,20 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
 UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Context, const FString& EnumPath)
 {
     // Check if we have already created this enum
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     if (UEnum* ExistingEnum = FindObject<UEnum>(nullptr, *EnumPath))
     {
         return ExistingEnum;
     }
+    // Objects in native packages are not parsed, so there is nothing to create this object from if it does not exist in the editor
+    if (IsObjectSkippedDuringParse(Context, EnumPath))
+    {
+        return nullptr;
+    }
 
-    const TSharedPtr<FJsonObject> EnumDefinition = Context.GlobalObjectMap->GetObjectField(EnumPath);
+    SUZIE_TRACE_SCOPE(CreateEnum);
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieEnumsCreated);
+    const TSharedPtr<FJsonObject> EnumDefinition = FindObjectDefinition(Context, EnumPath);
     checkf(EnumDefinition.IsValid(), TEXT("Failed to find enum object by path %s"), *EnumPath);
     
     const FString ObjectType = EnumDefinition->GetStringField(TEXT("type"));
@@ -614,7 +1429,8 @@ UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Cont
     // Create a package for the struct or reuse the existing package. Make sure it's marked as Native package
     UPackage* Package = FindOrCreatePackage(Context, PackageName);
     
-    UEnum* NewEnum = NewObject<UEnum>(Package, *ObjectName, RF_Public | RF_MarkAsRootSet);
+    UEnum* NewEnum = NewObject<UEnum>(Package, *ObjectName, RF_Public);
+    KeepGeneratedObjectAlive(NewEnum);
 
     // Set CppType. It is generally not used by the engine, but is useful to determine whenever enum is namespaced or not for CppForm deduction
     NewEnum->CppType = EnumDefinition->GetStringField(TEXT("cpp_type"));
@@ -647,7 +1463,10 @@ UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Cont
     NewEnum->SetEnums(EnumNames, EnumCppForm, EnumFlags, false);
 
     // Mark all dynamic enums as blueprint types
-    NewEnum->SetMetaData(*FBlueprintMetadata::MD_AllowableBlueprintVariableType.ToString(), TEXT("true"));
+    if (GetBlueprintExposure(NewEnum).bExposeTypes)
+    {
+        AddPendingMetaData(Context, NewEnum, FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
+    }
     
     UE_LOG(LogSuzie, Verbose, TEXT("Created enum: %s"), *ObjectName);
 
@@ -657,11 +1476,18 @@ UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Cont
 UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationContext& Context, const FString& FunctionPath)
 {
     // Check if the function already exists
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     if (UFunction* ExistingFunction = FindObject<UFunction>(nullptr, *FunctionPath))
     {
         return ExistingFunction;
     }
+    // Objects in native packages are not parsed, so there is nothing to create this object from if it does not exist in the editor
+    if (IsObjectSkippedDuringParse(Context, FunctionPath))
+    {
+        return nullptr;
+    }
     
+    SUZIE_TRACE_SCOPE(CreateFunction);
     FString ClassPathOrPackageName;
     FString ObjectName;
     ParseObjectPath(FunctionPath, ClassPathOrPackageName, ObjectName);
@@ -673,6 +1499,11 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
     {
         // This is a class path because it is at least two levels deep. We do not need our outer to be registered, just to exist
         FunctionOuterObject = FindOrCreateUnregisteredClass(Context, ClassPathOrPackageName);
+        if (FunctionOuterObject == nullptr)
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to find outer class %s for function %s"), *ClassPathOrPackageName, *FunctionPath);
+            return nullptr;
+        }
     }
     else
     {
@@ -681,6 +1512,7 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
     }
 
     // Check if the function already exists in its parent object
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     if (UFunction* ExistingFunction = FindObjectFast<UFunction>(FunctionOuterObject, *ObjectName))
     {
         return ExistingFunction;
@@ -717,7 +1549,7 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
         {TEXT("FUNC_HasDefaults"), FUNC_HasDefaults},
     };
 
-    const TSharedPtr<FJsonObject> FunctionDefinition = Context.GlobalObjectMap->GetObjectField(FunctionPath);
+    const TSharedPtr<FJsonObject> FunctionDefinition = FindObjectDefinition(Context, FunctionPath);
     checkf(FunctionDefinition.IsValid(), TEXT("Failed to find function object by path %s"), *FunctionPath);
     
     const FString ObjectType = FunctionDefinition->GetStringField(TEXT("type"));
@@ -735,8 +1567,10 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
     }
 
     // Have to temporarily mark the function as RF_ArchetypeObject to be able to create functions with UPackage as outer
-    UFunction* NewFunction = NewObject<UFunction>(FunctionOuterObject, *ObjectName, RF_Public | RF_MarkAsRootSet | RF_ArchetypeObject);
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFunctionsCreated);
+    UFunction* NewFunction = NewObject<UFunction>(FunctionOuterObject, *ObjectName, RF_Public | RF_ArchetypeObject);
     NewFunction->ClearFlags(RF_ArchetypeObject);
+    KeepGeneratedObjectAlive(NewFunction);
     NewFunction->FunctionFlags |= FunctionFlags;
 
     // Since this function is not marked as Native, we have to initialize Script bytecode for it
@@ -766,13 +1600,13 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
         // Object properties called WorldContext/WorldContextObject are automatically tagged as world context for convenience
         if (Property->IsA<FObjectProperty>() && (Property->GetFName() == TEXT("WorldContext") || Property->GetFName() == TEXT("WorldContextObject")))
         {
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_WorldContext, *Property->GetName());
+            AddPendingMetaData(Context, NewFunction, FBlueprintMetadata::MD_WorldContext, Property->GetName());
         }
         // Latent Info struct parameter properties should always be tagged as LatentInfo and indicate async BP functions
         if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && StructProperty->Struct == FLatentActionInfo::StaticStruct())
         {
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_LatentInfo, *Property->GetName());
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_Latent, TEXT("true"));
+            AddPendingMetaData(Context, NewFunction, FBlueprintMetadata::MD_LatentInfo, Property->GetName());
+            AddPendingMetaData(Context, NewFunction, FBlueprintMetadata::MD_Latent, TEXT("true"));
         }
     }
 
@@ -814,6 +1648,7 @@ TSet<FString> FSuziePluginModule::ParseFlags(const FString& Flags)
 
 FProperty* FSuziePluginModule::AddPropertyToStruct(FDynamicClassGenerationContext& Context, UStruct* Struct, const TSharedPtr<FJsonObject>& PropertyJson, const EPropertyFlags ExtraPropertyFlags)
 {
+    SUZIE_TRACE_SCOPE(AddProperty);
     if (FProperty* NewProperty = BuildProperty(Context, Struct, PropertyJson, ExtraPropertyFlags))
     {
         // This property will always be linked as a last element of the list, so it has no next element
@@ -846,6 +1681,12 @@ void FSuziePluginModule::AddFunctionToClass(FDynamicClassGenerationContext& Cont
     {
         // Append additional flags to the function
         NewFunction->FunctionFlags |= ExtraFunctionFlags;
+
+        // Hidden functions can still be overriden as events, but they cannot be called
+        if (!GetBlueprintExposure(Class).bExposeFunctions)
+        {
+            NewFunction->FunctionFlags &= ~(FUNC_BlueprintCallable | FUNC_BlueprintPure);
+        }
         
         // This function will always be linked as a last element of the list, so it has no next element
         NewFunction->Next = nullptr;
@@ -873,7 +1714,83 @@ void FSuziePluginModule::AddFunctionToClass(FDynamicClassGenerationContext& Cont
     }
 }
 
+// Checks that the descriptors only differ in the name of the property. Names of nested properties are compared, since they are duplicated from the prototype
+static bool ArePropertyDescriptorsEquivalent(const TSharedPtr<FJsonObject>& A, const TSharedPtr<FJsonObject>& B)
+{
+    if (A->Values.Num() != B->Values.Num())
+    {
+        return false;
+    }
+    for (const auto& [FieldName, FieldValue] : A->Values)
+    {
+        if (FieldName == TEXT("name"))
+        {
+            continue;
+        }
+        const TSharedPtr<FJsonValue>* OtherFieldValue = B->Values.Find(FieldName);
+        if (OtherFieldValue == nullptr || !FieldValue.IsValid() || !OtherFieldValue->IsValid() || !FJsonValue::CompareEqual(*FieldValue, **OtherFieldValue))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags)
+{
+    // Dumps repeat the same property shapes many times, e.g. float properties with the same flags or arrays of the same object type
+    uint32 PrototypeHash = GetTypeHash(static_cast<uint64>(ExtraPropertyFlags));
+    for (const auto& [FieldName, FieldValue] : PropertyJson->Values)
+    {
+        if (FieldName != TEXT("name"))
+        {
+            PrototypeHash = HashCombine(PrototypeHash, HashCombine(FCrc::StrCrc32(*FieldName), HashJsonValue(FieldValue)));
+        }
+    }
+    const FName PropertyName(*PropertyJson->GetStringField(TEXT("name")));
+
+    if (const TArray<FSuziePropertyPrototype>* Prototypes = PropertyPrototypes.Find(PrototypeHash))
+    {
+        for (const FSuziePropertyPrototype& Prototype : *Prototypes)
+        {
+            if (Prototype.ExtraPropertyFlags == ExtraPropertyFlags && ArePropertyDescriptorsEquivalent(Prototype.Descriptor, PropertyJson))
+            {
+                Context.NumPropertiesFromPrototypes++;
+                SUZIE_TRACE_COUNTER_INCREMENT(SuziePropertiesFromPrototypes);
+                // Duplicates the nested properties as well, and copies the flags, the resolved types and the bool layout
+                return CastFieldChecked<FProperty>(FField::Duplicate(Prototype.Property, Owner, PropertyName));
+            }
+        }
+    }
+
+    const int32 NumGenerationFallbacksBefore = GenerationFallbacks.Num();
+    FProperty* NewProperty = BuildPropertyFromDescriptor(Context, Owner, PropertyJson, ExtraPropertyFlags);
+    // Types that could not be found might only be missing temporarily, e.g. while their class is being constructed, so fallbacks are not made into prototypes.
+    // Neither are unsupported property types, which are rare
+    if (NewProperty && GenerationFallbacks.Num() == NumGenerationFallbacksBefore)
+    {
+        // Building the property builds nested properties and struct members as well, which adds prototypes, so the array has to be looked up again
+        FProperty* PrototypeProperty = CastFieldChecked<FProperty>(FField::Duplicate(NewProperty, FFieldVariant(), PropertyName));
+        KeepFieldReferencesAlive(PrototypeProperty);
+        PropertyPrototypes.FindOrAdd(PrototypeHash).Add({PropertyJson, ExtraPropertyFlags, PrototypeProperty});
+    }
+    return NewProperty;
+}
+
+void FSuziePluginModule::ResetPropertyPrototypes()
+{
+    for (const auto& [PrototypeHash, Prototypes] : PropertyPrototypes)
+    {
+        for (const FSuziePropertyPrototype& Prototype : Prototypes)
+        {
+            ReleaseFieldReferences(Prototype.Property);
+            delete Prototype.Property;
+        }
+    }
+    PropertyPrototypes.Empty();
+}
+
+FProperty* FSuziePluginModule::BuildPropertyFromDescriptor(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags)
 {
     // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
     static const TArray<TPair<FString, EPropertyFlags>> PropertyFlagNameLookup = {
@@ -956,8 +1873,10 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
     if (NewProperty == nullptr)
     {
         UE_LOG(LogSuzie, Warning, TEXT("Failed to create property of type %s: not supported"), *PropertyType);
+        AddGenerationFallback(Owner, PropertyName, PropertyType, nullptr);
         return nullptr;
     }
+    SUZIE_TRACE_COUNTER_INCREMENT(SuziePropertiesBuilt);
     
     NewProperty->ArrayDim = PropertyJson->GetIntegerField(TEXT("array_dim"));
     NewProperty->PropertyFlags |= PropertyFlags;
@@ -967,6 +1886,10 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
         UClass* PropertyClass = FindOrCreateUnregisteredClass(Context, *PropertyJson->GetStringField(TEXT("property_class")));
         // Fall back to UObject class if property class could not be found
         ObjectPropertyBase->PropertyClass = PropertyClass ? PropertyClass : UObject::StaticClass();
+        if (PropertyClass == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("property_class")), UObject::StaticClass());
+        }
         
         // Class properties additionally define MetaClass value
         if (FClassProperty* ClassProperty = CastField<FClassProperty>(NewProperty))
@@ -974,12 +1897,20 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
             UClass* MetaClass = FindOrCreateUnregisteredClass(Context, *PropertyJson->GetStringField(TEXT("meta_class")));
             // Fall back to UObject meta-class if meta-class could not be found
             ClassProperty->MetaClass = MetaClass ? MetaClass : UObject::StaticClass();
+            if (MetaClass == nullptr)
+            {
+                AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("meta_class")), UObject::StaticClass());
+            }
         }
         else if (FSoftClassProperty* SoftClassProperty = CastField<FSoftClassProperty>(NewProperty))
         {
             UClass* MetaClass = FindOrCreateUnregisteredClass(Context, *PropertyJson->GetStringField(TEXT("meta_class")));
             // Fall back to UObject meta-class if meta-class could not be found
             SoftClassProperty->MetaClass = MetaClass ? MetaClass : UObject::StaticClass();
+            if (MetaClass == nullptr)
+            {
+                AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("meta_class")), UObject::StaticClass());
+            }
         }
     }
     else if (FInterfaceProperty* InterfaceProperty = CastField<FInterfaceProperty>(NewProperty))
@@ -987,18 +1918,30 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
         UClass* InterfaceClass = FindOrCreateUnregisteredClass(Context, *PropertyJson->GetStringField(TEXT("interface_class")));
         // Fall back to UInterface if interface class could not be found
         InterfaceProperty->InterfaceClass = InterfaceClass ? InterfaceClass : UInterface::StaticClass();
+        if (InterfaceClass == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("interface_class")), UInterface::StaticClass());
+        }
     }
     else if (FStructProperty* StructProperty = CastField<FStructProperty>(NewProperty))
     {
         UScriptStruct* Struct = FindOrCreateScriptStruct(Context, PropertyJson->GetStringField(TEXT("struct")));
         // Fall back to FVector if struct class could not be found
         StructProperty->Struct = Struct ? Struct : TBaseStructure<FVector>::Get();
+        if (Struct == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("struct")), TBaseStructure<FVector>::Get());
+        }
     }
     else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(NewProperty))
     {
         UEnum* Enum = FindOrCreateEnum(Context, PropertyJson->GetStringField(TEXT("enum")));
         // Fall back to EMovementMode if enum class could not be found
         EnumProperty->SetEnum(Enum ? Enum : StaticEnum<EMovementMode>());
+        if (Enum == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("enum")), StaticEnum<EMovementMode>());
+        }
 
         FProperty* UnderlyingProp = BuildProperty(Context, EnumProperty, PropertyJson->GetObjectField(TEXT("container")));
         EnumProperty->AddCppProperty(UnderlyingProp);
@@ -1011,6 +1954,10 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
             UEnum* Enum = FindOrCreateEnum(Context, PropertyJson->GetStringField(TEXT("enum")));
             // Fall back to EMovementMode if enum class could not be found
             ByteProperty->Enum = Enum ? Enum : StaticEnum<EMovementMode>();
+            if (Enum == nullptr)
+            {
+                AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("enum")), StaticEnum<EMovementMode>());
+            }
         }
     }
     else if (FDelegateProperty* DelegateProperty = CastField<FDelegateProperty>(NewProperty))
@@ -1018,12 +1965,33 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
         UFunction* SignatureFunction = FindOrCreateFunction(Context, PropertyJson->GetStringField(TEXT("signature_function")));
         // Fall back to FOnTimelineEvent delegate signature in the engine if real delegate signature could not be found
         DelegateProperty->SignatureFunction = SignatureFunction ? SignatureFunction : FindObject<UFunction>(nullptr, TEXT("/Script/Engine.OnTimelineEvent__DelegateSignature"));
+        if (SignatureFunction == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("signature_function")), DelegateProperty->SignatureFunction);
+        }
     }
     else if (FMulticastDelegateProperty* MulticastDelegateProperty = CastField<FMulticastDelegateProperty>(NewProperty))
     {
         UFunction* SignatureFunction = FindOrCreateFunction(Context, PropertyJson->GetStringField(TEXT("signature_function")));
         // Fall back to FOnTimelineEvent delegate signature in the engine if real delegate signature could not be found
         MulticastDelegateProperty->SignatureFunction = SignatureFunction ? SignatureFunction : FindObject<UFunction>(nullptr, TEXT("/Script/Engine.OnTimelineEvent__DelegateSignature"));
+        if (SignatureFunction == nullptr)
+        {
+            AddGenerationFallback(Owner, PropertyName, PropertyJson->GetStringField(TEXT("signature_function")), MulticastDelegateProperty->SignatureFunction);
+        }
+    }
+    else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(NewProperty))
+    {
+        // Restore the bitfield layout of the bool. Older dumps do not have it, in which case the bool takes an entire byte. The mask of a bool
+        // is 32 bits wide, so bitfields of 64-bit integers cannot be represented and keep the default layout as well
+        int32 FieldSize, ByteOffset, FieldMask;
+        if (PropertyJson->TryGetNumberField(TEXT("field_size"), FieldSize) && PropertyJson->TryGetNumberField(TEXT("byte_offset"), ByteOffset) &&
+            PropertyJson->TryGetNumberField(TEXT("field_mask"), FieldMask) && FieldSize > 0 && FieldSize <= (int32)sizeof(uint32) &&
+            ByteOffset >= 0 && ByteOffset < FieldSize && FieldMask > 0 && FieldMask <= 0xFF)
+        {
+            const bool bIsNativeBool = FieldMask == 0xFF;
+            BoolProperty->SetBoolSize(FieldSize, bIsNativeBool, bIsNativeBool ? 0 : static_cast<uint32>(FieldMask) << (ByteOffset * 8));
+        }
     }
     else if (FFieldPathProperty* FieldPathProperty = CastField<FFieldPathProperty>(NewProperty))
     {
@@ -1067,12 +2035,113 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
     return NewProperty;
 }
 
-bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FString& ObjectPath, FDynamicObjectConstructionData& ObjectConstructionData)
+void FSuziePluginModule::AddGenerationFallback(const FFieldVariant Owner, const FString& PropertyName, const FString& MissingTypePath, const UObject* FallbackType)
 {
-    // Retrieve the data for the object
-    const TSharedPtr<FJsonObject> ObjectDefinition = Context.GlobalObjectMap->GetObjectField(ObjectPath);
-    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find data object by path %s"), *ObjectPath);
+    GenerationFallbacks.Add({Owner.GetPathName(), PropertyName, MissingTypePath, FallbackType ? FallbackType->GetName() : FString()});
+}
+
+bool FSuziePluginModule::MatchesObjectPathPattern(const FString& ObjectPath, const FString& Pattern)
+{
+    // Patterns can be object paths, package names or wildcards
+    if (Pattern.Contains(TEXT("*")) || Pattern.Contains(TEXT("?")))
+    {
+        return ObjectPath.MatchesWildcard(Pattern);
+    }
+    if (ObjectPath == Pattern)
+    {
+        return true;
+    }
+    // Package name matches all objects inside the package
+    return ObjectPath.Len() > Pattern.Len() && ObjectPath[Pattern.Len()] == '.' && ObjectPath.StartsWith(Pattern);
+}
+
+FSuzieBlueprintExposureRule FSuziePluginModule::GetBlueprintExposure(const UObject* Type)
+{
+    const TArray<FSuzieBlueprintExposureRule>& ExposureRules = GetDefault<USuzieSettings>()->BlueprintExposureRules;
+    if (ExposureRules.IsEmpty())
+    {
+        return FSuzieBlueprintExposureRule();
+    }
+    // Last matching rule wins, so look for it from the end
+    const FString TypePath = Type->GetPathName();
+    for (int32 RuleIndex = ExposureRules.Num() - 1; RuleIndex >= 0; RuleIndex--)
+    {
+        if (MatchesObjectPathPattern(TypePath, ExposureRules[RuleIndex].Pattern))
+        {
+            return ExposureRules[RuleIndex];
+        }
+    }
+    return FSuzieBlueprintExposureRule();
+}
+
+void FSuziePluginModule::AddPendingMetaData(FDynamicClassGenerationContext& Context, const UObject* Object, const FName& Key, const FString& Value)
+{
+    Context.PendingMetaData.FindOrAdd(Object).Add(Key, Value);
+}
+
+void FSuziePluginModule::FlushPendingMetaData(FDynamicClassGenerationContext& Context)
+{
+    // Objects are created in the order of the dump, so objects of the same package are usually next to each other
+    UPackage* LastPackage = nullptr;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+    FMetaData* PackageMetaData = nullptr;
+#else
+    UMetaData* PackageMetaData = nullptr;
+#endif
+    for (auto& [Object, ObjectMetaData] : Context.PendingMetaData)
+    {
+        UPackage* Package = Object->GetOutermost();
+        if (Package != LastPackage)
+        {
+            LastPackage = Package;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+            PackageMetaData = &Package->GetMetaData();
+#else
+            PackageMetaData = Package->GetMetaData();
+#endif
+        }
+        PackageMetaData->SetObjectValues(Object, MoveTemp(ObjectMetaData));
+    }
+    Context.PendingMetaData.Empty();
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::FindObjectDefinition(const FDynamicClassGenerationContext& Context, const FString& ObjectPath)
+{
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieDefinitionLookups);
+    const TSharedPtr<FJsonValue>* ObjectValue = Context.GlobalObjectMap->Values.Find(ObjectPath);
+    if (ObjectValue == nullptr && Context.FindUnloadedObjectDefinition)
+    {
+        return Context.FindUnloadedObjectDefinition(ObjectPath);
+    }
+    return ObjectValue ? (*ObjectValue)->AsObject() : nullptr;
+}
+
+void FSuziePluginModule::SetupOnDemandObjectDefinitions(FDynamicClassGenerationContext& Context)
+{
+    // Streamed dumps are parsed one object at a time as generation needs them
+    if (StreamedDumpIndex.IsValid())
+    {
+        Context.FindUnloadedObjectDefinition = [this](const FString& ObjectPath) { return StreamedDumpIndex->FindObjectDefinition(ObjectPath); };
+    }
+    // Objects of the shards that have not been loaded at startup are loaded when generation references them
+    else if (!DumpShardFilePathByPackageName.IsEmpty())
+    {
+        Context.FindUnloadedObjectDefinition = [this](const FString& ObjectPath) { return LoadObjectDefinitionFromShard(ObjectPath); };
+    }
+}
+
+bool FSuziePluginModule::IsObjectSkippedDuringParse(const FDynamicClassGenerationContext& Context, const FString& ObjectPath)
+{
+    if (Context.SkippedObjectPaths == nullptr || !Context.SkippedObjectPaths->Contains(ObjectPath))
+    {
+        return false;
+    }
+    UE_LOG(LogSuzie, Error, TEXT("Object %s has been skipped because its package is native, but it does not exist in the editor. Add the package to the list of packages that are not skipped in Suzie settings"), *ObjectPath);
+    return true;
+}
 
+bool FSuziePluginModule::ParseObjectConstructionData(const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition, FDynamicObjectConstructionData& ObjectConstructionData)
+{
     FString OuterObjectPath;
     FString ObjectName;
     ParseObjectPath(ObjectPath, OuterObjectPath, ObjectName);
@@ -1080,6 +2149,7 @@ bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicClassGenerati
 
     // Find the class of this object
     const FString ObjectClassPath = ObjectDefinition->GetStringField(TEXT("class"));
+    SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
     ObjectConstructionData.ObjectClass = FindObject<UClass>(nullptr, *ObjectClassPath);
     if (ObjectConstructionData.ObjectClass == nullptr)
     {
@@ -1111,6 +2181,56 @@ bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicClassGenerati
     return true;
 }
 
+FDynamicObjectTreeNode& FSuziePluginModule::FindOrAddObjectTreeNode(FDynamicClassGenerationContext& Context, const FString& ObjectPath)
+{
+    if (const TUniquePtr<FDynamicObjectTreeNode>* ExistingNode = Context.ObjectTree.Find(ObjectPath))
+    {
+        return **ExistingNode;
+    }
+    const TSharedPtr<FJsonObject> ObjectDefinition = FindObjectDefinition(Context, ObjectPath);
+    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find data object by path %s"), *ObjectPath);
+    TUniquePtr<FDynamicObjectTreeNode> NewNode = MakeUnique<FDynamicObjectTreeNode>();
+    NewNode->ObjectPath = ObjectPath;
+    NewNode->bIsValid = ParseObjectConstructionData(ObjectPath, ObjectDefinition, NewNode->ConstructionData);
+    return *Context.ObjectTree.Add(ObjectPath, MoveTemp(NewNode));
+}
+
+const TArray<FDynamicObjectTreeNode*>& FSuziePluginModule::GetObjectTreeNodeChildren(FDynamicClassGenerationContext& Context, FDynamicObjectTreeNode& Node)
+{
+    if (!Node.bHasResolvedChildren)
+    {
+        Node.bHasResolvedChildren = true;
+        const TSharedPtr<FJsonObject> ObjectDefinition = FindObjectDefinition(Context, Node.ObjectPath);
+        const TArray<TSharedPtr<FJsonValue>>* Children;
+        if (ObjectDefinition.IsValid() && ObjectDefinition->TryGetArrayField(TEXT("children"), Children))
+        {
+            Node.Children.Reserve(Children->Num());
+            for (const TSharedPtr<FJsonValue>& ChildJsonValue : *Children)
+            {
+                Node.Children.Add(&FindOrAddObjectTreeNode(Context, ChildJsonValue->AsString()));
+            }
+        }
+    }
+    return Node.Children;
+}
+
+const TArray<FName>& FSuziePluginModule::GetNativeDefaultSubobjectNames(FDynamicClassGenerationContext& Context, const UClass* NativeClass)
+{
+    if (const TArray<FName>* ExistingSubobjectNames = Context.NativeDefaultSubobjectNames.Find(NativeClass))
+    {
+        return *ExistingSubobjectNames;
+    }
+    TArray<FName> SubobjectNames;
+    ForEachObjectWithOuter(NativeClass->GetDefaultObject(), [&](const UObject* ArchetypeDefaultSubobject)
+    {
+        if (ArchetypeDefaultSubobject->HasAnyFlags(RF_DefaultSubObject))
+        {
+            SubobjectNames.Add(ArchetypeDefaultSubobject->GetFName());
+        }
+    }, false);
+    return Context.NativeDefaultSubobjectNames.Add(NativeClass, MoveTemp(SubobjectNames));
+}
+
 void FSuziePluginModule::DeserializeEnumValue(const FNumericProperty* UnderlyingProperty, void* PropertyValuePtr, const UEnum* Enum, const TSharedPtr<FJsonValue>& JsonPropertyValue)
 {
     if (JsonPropertyValue->Type == EJson::String)
@@ -1159,6 +2279,7 @@ void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, voi
         if (!JsonPropertyValue->IsNull())
         {
             // For all other object properties, we must already have the object pointed at in memory, we will not load any objects here
+            SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
             UObject* Object = StaticFindObject(ObjectProperty->PropertyClass, nullptr, *JsonPropertyValue->AsString());
             ObjectProperty->SetObjectPropertyValue(PropertyValuePtr, Object);
         }
@@ -1243,6 +2364,7 @@ void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, voi
         const TArray<TSharedPtr<FJsonValue>>& ArrayElementJsonValues = JsonPropertyValue->AsArray();
         FScriptArrayHelper ArrayValueHelper(ArrayProperty, PropertyValuePtr);
 
+        // Existing elements keep the values inherited from the parent default object. New zero constructed elements are cleared with a single memset by Resize
         ArrayValueHelper.Resize(ArrayElementJsonValues.Num());
         for (int32 ElementIndex = 0; ElementIndex < ArrayElementJsonValues.Num(); ElementIndex++)
         {
@@ -1256,7 +2378,9 @@ void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, voi
     {
         const TArray<TSharedPtr<FJsonValue>>& SetElementJsonValues = JsonPropertyValue->AsArray();
         FScriptSetHelper SetValueHelper(SetProperty, PropertyValuePtr);
-        
+
+        // Start from an empty set so that deserializing on top of existing values (e.g. when the dump is reloaded) replaces them
+        SetValueHelper.EmptyElements(SetElementJsonValues.Num());
         for (const TSharedPtr<FJsonValue>& ElementJsonValue : SetElementJsonValues)
         {
             const int32 NewElementIndex = SetValueHelper.AddDefaultValue_Invalid_NeedsRehash();
@@ -1269,7 +2393,9 @@ void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, voi
     {
         const TArray<TSharedPtr<FJsonValue>>& MapPairJsonValues = JsonPropertyValue->AsArray();
         FScriptMapHelper MapValueHelper(MapProperty, PropertyValuePtr);
-        
+
+        // Start from an empty map so that deserializing on top of existing values (e.g. when the dump is reloaded) replaces them
+        MapValueHelper.EmptyValues(MapPairJsonValues.Num());
         for (const TSharedPtr<FJsonValue>& ElementJsonValue : MapPairJsonValues)
         {
             const int32 NewPairIndex = MapValueHelper.AddDefaultValue_Invalid_NeedsRehash();
@@ -1354,6 +2480,11 @@ void FSuziePluginModule::PolymorphicClassConstructorInvocationHelper(const FObje
     const FDynamicClassConstructionData* TopLevelClassConstructionData = DynamicClassConstructionData.Find(TopLevelDynamicClass);
     checkf(TopLevelClassConstructionData, TEXT("Failed to find dynamic class construction data for dynamic class %s"), *TopLevelDynamicClass->GetPathName());
 
+    // Time includes the construction of default subobjects, and of any other dynamic class objects created by the constructors
+    SCOPE_CYCLE_COUNTER(STAT_SuzieDynamicObjectConstruction);
+    INC_DWORD_STAT(STAT_SuzieDynamicObjectsConstructed);
+    FSuzieConstructionStats::FScopedConstruction ConstructionStatsScope(TopLevelClassConstructionData->ConstructionStats.Get());
+
     // Gather all dynamic classes that contribute to the object being constructed, starting at the top level one
     // We need this list BEFORE applying subobject overrides to handle the entire hierarchy
     TArray<const UClass*, TInlineAllocator<8>> DynamicClassHierarchyTree;
@@ -1460,21 +2591,20 @@ void FSuziePluginModule::ExecutePolymorphicClassConstructorFrameForDynamicClass(
             ObjectInitializer.CreateDefaultSubobject(ObjectInitializer.GetObj(),
                 SubobjectConstructionData.ObjectName, UObject::StaticClass(), SubobjectConstructionData.ObjectClass,
                 true, EnumHasAnyFlags(SubobjectConstructionData.ObjectFlags, RF_Transient));
+            INC_DWORD_STAT(STAT_SuzieDynamicSubobjectsCreated);
+            FSuzieConstructionStats::CountSubobjectCreated(ClassConstructionData->ConstructionStats.Get());
         }
     }
 }
 
-void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName> SubobjectNameStack, const FString& SubobjectPath, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData)
+void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName>& SubobjectNameStack, FDynamicObjectTreeNode& SubobjectNode, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData)
 {
-    const TSharedPtr<FJsonObject> ObjectDefinition = Context.GlobalObjectMap->GetObjectField(SubobjectPath);
-    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find subobject object by path %s"), *SubobjectPath);
-    
-    // Parse construction data for this object first. Skip if this is not a subobject
-    FDynamicObjectConstructionData ObjectConstructionData;
-    if (!ParseObjectConstructionData(Context, SubobjectPath, ObjectConstructionData) || !EnumHasAnyFlags(ObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
+    // Skip if this is not a subobject
+    if (!SubobjectNode.IsDefaultSubobject())
     {
         return;
     }
+    const FDynamicObjectConstructionData& ObjectConstructionData = SubobjectNode.ConstructionData;
     // Class of the overriden default subobject might not have been finalized yet, in which case we have to finalize it now to have its archetype with correct values
     if (Context.ClassesPendingFinalization.Contains(ObjectConstructionData.ObjectClass))
     {
@@ -1489,21 +2619,20 @@ void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(FDynamicClas
     }
 
     // Iterate over children and collect nested default subobject overrides for them
-    if (ObjectDefinition->HasTypedField<EJson::Array>(TEXT("children")))
+    for (FDynamicObjectTreeNode* ChildNode : GetObjectTreeNodeChildren(Context, SubobjectNode))
     {
-        const TArray<TSharedPtr<FJsonValue>>& Children = ObjectDefinition->GetArrayField(TEXT("children"));
-        for (const TSharedPtr<FJsonValue>& ChildJsonValue : Children)
-        {
-            // CollectNestedDefaultSubobjectTypeOverrides will discard children that are not actually subobjects
-            const FString ChildPath = ChildJsonValue->AsString();
-            CollectNestedDefaultSubobjectTypeOverrides(Context, SubobjectNameStack, ChildPath, OutSubobjectOverrideData);
-        }
+        // CollectNestedDefaultSubobjectTypeOverrides will discard children that are not actually subobjects
+        CollectNestedDefaultSubobjectTypeOverrides(Context, SubobjectNameStack, *ChildNode, OutSubobjectOverrideData);
     }
+    SubobjectNameStack.Pop();
 }
 
-void FSuziePluginModule::DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const TSharedPtr<FJsonObject>& ObjectDefinition)
+void FSuziePluginModule::DeserializeObjectAndSubobjectPropertyValuesRecursive(FDynamicClassGenerationContext& Context, UObject* Object, FDynamicObjectTreeNode& ObjectNode)
 {
+    SUZIE_TRACE_SCOPE(DeserializeObjectValues);
     // Deserialize property values for this object first
+    const TSharedPtr<FJsonObject> ObjectDefinition = FindObjectDefinition(Context, ObjectNode.ObjectPath);
+    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find data object by path %s"), *ObjectNode.ObjectPath);
     if (ObjectDefinition->HasTypedField<EJson::Object>(TEXT("property_values")))
     {
         const TSharedPtr<FJsonObject> PropertyValues = ObjectDefinition->GetObjectField(TEXT("property_values"));
@@ -1511,25 +2640,17 @@ void FSuziePluginModule::DeserializeObjectAndSubobjectPropertyValuesRecursive(co
     }
 
     // Iterate over children and deserialize values for the ones that already exist as default subobjects
-    if (ObjectDefinition->HasTypedField<EJson::Array>(TEXT("children")))
+    for (FDynamicObjectTreeNode* ChildNode : GetObjectTreeNodeChildren(Context, ObjectNode))
     {
-        const TArray<TSharedPtr<FJsonValue>>& Children = ObjectDefinition->GetArrayField(TEXT("children"));
-        for (const TSharedPtr<FJsonValue>& ChildJsonValue : Children)
+        if (ChildNode->IsDefaultSubobject())
         {
-            const FString ChildPath = ChildJsonValue->AsString();
-            
-            // Parse object construction data and check if it is a default subobject
-            FDynamicObjectConstructionData ObjectConstructionData;
-            if (ParseObjectConstructionData(Context, ChildPath, ObjectConstructionData) && EnumHasAnyFlags(ObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
-            {
-                const TSharedPtr<FJsonObject> SubobjectDefinition = Context.GlobalObjectMap->GetObjectField(ChildPath);
-                UObject* SubobjectInstance = StaticFindObjectFast(ObjectConstructionData.ObjectClass, Object, ObjectConstructionData.ObjectName);
+            SUZIE_TRACE_COUNTER_INCREMENT(SuzieFindObjectCalls);
+            UObject* SubobjectInstance = StaticFindObjectFast(ChildNode->ConstructionData.ObjectClass, Object, ChildNode->ConstructionData.ObjectName);
 
-                // If we have a constructed subobject instance, deserialize the properties into that instance
-                if (SubobjectDefinition && SubobjectInstance && SubobjectInstance->HasAnyFlags(RF_DefaultSubObject))
-                {
-                    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, SubobjectInstance, SubobjectDefinition);   
-                }
+            // If we have a constructed subobject instance, deserialize the properties into that instance
+            if (SubobjectInstance && SubobjectInstance->HasAnyFlags(RF_DefaultSubObject))
+            {
+                DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, SubobjectInstance, *ChildNode);
             }
         }
     }
@@ -1545,6 +2666,8 @@ void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context,
 
     // Find the definition for the class default object
     const FString ClassDefaultObjectPath = Context.ClassesPendingFinalization.FindAndRemoveChecked(Class);
+    SUZIE_TRACE_SCOPE_TEXT(*ClassDefaultObjectPath);
+    FSuzieGenerationProfile::FScopedType ProfileType(GenerationProfile.Get(), Class->GetPathName());
 
     // Finalize our parent class first since we require parent class CDO to be populated before CDO for this class can be created
     UClass* ParentClass = Class->GetSuperClass();
@@ -1553,20 +2676,18 @@ void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context,
         FinalizeClass(Context, ParentClass);
     }
 
-    const TSharedPtr<FJsonObject> ClassDefaultObjectDefinition = Context.GlobalObjectMap->GetObjectField(ClassDefaultObjectPath);
-    checkf(ClassDefaultObjectDefinition.IsValid(), TEXT("Failed to find default object by path %s"), *ClassDefaultObjectPath);
+    FDynamicObjectTreeNode& ClassDefaultObjectNode = FindOrAddObjectTreeNode(Context, ClassDefaultObjectPath);
 
     // Iterate child objects of the class default object to find default subobjects that we want to construct before we deserialize the data
     FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindOrAdd(Class);
     TSet<FName> CreatedDefaultSubobjects;
+    TArray<FName> SubobjectNameStack;
     
-    const TArray<TSharedPtr<FJsonValue>>& Children = ClassDefaultObjectDefinition->GetArrayField(TEXT("children"));
-    for (const TSharedPtr<FJsonValue>& ChildObjectPathValue : Children)
+    for (FDynamicObjectTreeNode* ChildNode : GetObjectTreeNodeChildren(Context, ClassDefaultObjectNode))
     {
-        FString ChildPath = ChildObjectPathValue->AsString();
-        FDynamicObjectConstructionData ChildObjectConstructionData;
-        if (ParseObjectConstructionData(Context, ChildPath, ChildObjectConstructionData) && EnumHasAnyFlags(ChildObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
+        if (ChildNode->IsDefaultSubobject())
         {
+            const FDynamicObjectConstructionData& ChildObjectConstructionData = ChildNode->ConstructionData;
             // Class of our default subobject might not have been finalized yet, in which case we have to finalize it now to have its archetype with correct values
             if (Context.ClassesPendingFinalization.Contains(ChildObjectConstructionData.ObjectClass))
             {
@@ -1576,20 +2697,20 @@ void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context,
             CreatedDefaultSubobjects.Add(ChildObjectConstructionData.ObjectName);
             
             // Collect subobject overrides for this subobject
-            CollectNestedDefaultSubobjectTypeOverrides(Context, TArray<FName>(), ChildPath, ClassConstructionData.DefaultSubobjectOverrides);
+            CollectNestedDefaultSubobjectTypeOverrides(Context, SubobjectNameStack, *ChildNode, ClassConstructionData.DefaultSubobjectOverrides);
         }
     }
 
     // Iterate default subobjects of our parent native class. If we have not created one of them, it means it has been explicitly disabled
     // TODO: This does not handle disabled nested default subobjects.
     const UClass* NativeParentClass = GetNativeParentClassForDynamicClass(Class);
-    ForEachObjectWithOuter(NativeParentClass->GetDefaultObject(), [&](const UObject* ArchetypeDefaultSubobject)
+    for (const FName& NativeDefaultSubobjectName : GetNativeDefaultSubobjectNames(Context, NativeParentClass))
     {
-        if (ArchetypeDefaultSubobject->HasAnyFlags(RF_DefaultSubObject) && !CreatedDefaultSubobjects.Contains(ArchetypeDefaultSubobject->GetFName()))
+        if (!CreatedDefaultSubobjects.Contains(NativeDefaultSubobjectName))
         {
-            ClassConstructionData.SuppressedDefaultSubobjects.Add(ArchetypeDefaultSubobject->GetFName());
+            ClassConstructionData.SuppressedDefaultSubobjects.Add(NativeDefaultSubobjectName);
         }
-    }, false);
+    }
     
     // Assemble reference token stream for garbage collector
     Class->AssembleReferenceTokenStream(true);
@@ -1597,12 +2718,19 @@ void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context,
     UObject* ClassDefaultObject = Class->GetDefaultObject(true);
 
     // Recursively deserialize property values for the default object and its subobjects (and their nested subobjects)
-    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, ClassDefaultObject, ClassDefaultObjectDefinition);
+    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, ClassDefaultObject, ClassDefaultObjectNode);
 
     // Create an archetype by duplicating the CDO. We will use that archetype instead of CDO for priming the instances with correct values
+    CreateDefaultObjectArchetype(Class, ClassConstructionData);
+}
+
+void FSuziePluginModule::CreateDefaultObjectArchetype(UClass* Class, FDynamicClassConstructionData& ClassConstructionData)
+{
     // Do not create archetypes for NetConnection-derived classes, they have faulty shutdown logic leading to a crash on exit
     if (!Class->IsChildOf<UNetConnection>())
     {
+        SUZIE_TRACE_SCOPE(DuplicateArchetype);
+        UObject* ClassDefaultObject = Class->GetDefaultObject();
         const FString ArchetypeObjectName = TEXT("InitializationArchetype__") + Class->GetName();
         {
             FScopedAllowAbstractClassAllocation AllowAbstract;
@@ -1610,7 +2738,7 @@ void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context,
         }
         ClassConstructionData.DefaultObjectArchetype->ClearFlags(RF_ClassDefaultObject);
         ClassConstructionData.DefaultObjectArchetype->SetFlags(RF_Public | RF_ArchetypeObject | RF_Transactional);
-        ClassConstructionData.DefaultObjectArchetype->AddToRoot();
+        KeepGeneratedObjectAlive(ClassConstructionData.DefaultObjectArchetype);
     }
 }
 
@@ -0,0 +1,145 @@
+#include "SuziePlugin.h"
+#include "SuzieSettings.h"
+#include "SuzieObjectReferenceHelper.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Interfaces/IPluginManager.h"
+
+void FSuziePluginModule::GatherReachableTypeSeeds(TSet<FString>& OutSeedObjectPaths)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    // Project content is the game content and the content of the plugins of the project, which is where mods usually live
+    TArray<FString> ProjectContentPaths = {TEXT("/Game")};
+    for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPluginsWithContent())
+    {
+        if (Plugin->GetLoadedFrom() == EPluginLoadedFrom::Project)
+        {
+            ProjectContentPaths.Add(TEXT("/") + Plugin->GetName());
+        }
+    }
+
+    // Classes are generated before the initial asset scan finishes, so scan the project content now
+    AssetRegistry.ScanPathsSynchronous(ProjectContentPaths, false);
+
+    TArray<FAssetData> ProjectAssets;
+    for (const FString& ProjectContentPath : ProjectContentPaths)
+    {
+        AssetRegistry.GetAssetsByPath(FName(*ProjectContentPath), ProjectAssets, true);
+    }
+    TSet<FName> ProjectPackageNames;
+    for (const FAssetData& AssetData : ProjectAssets)
+    {
+        ProjectPackageNames.Add(AssetData.PackageName);
+        // Assets can be instances of game classes directly (e.g. data assets)
+        OutSeedObjectPaths.Add(AssetData.AssetClassPath.ToString());
+
+        // Blueprints need their parent class to be loaded, as well as the native class they are derived from
+        for (const FName ParentClassTagName : {FBlueprintTags::ParentClassPath, FBlueprintTags::NativeParentClassPath})
+        {
+            FString ParentClassExportPath;
+            if (AssetData.GetTagValue(ParentClassTagName, ParentClassExportPath))
+            {
+                OutSeedObjectPaths.Add(FPackageName::ExportTextPathToObjectPath(ParentClassExportPath));
+            }
+        }
+    }
+
+    // Blueprints also use types as variable, struct and enum types and call functions of them. The asset registry only knows which script packages
+    // they import from, so every object of those packages is seeded by adding the package name
+    TArray<FName> Dependencies;
+    for (const FName ProjectPackageName : ProjectPackageNames)
+    {
+        Dependencies.Reset();
+        AssetRegistry.GetDependencies(ProjectPackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+        for (const FName Dependency : Dependencies)
+        {
+            FString DependencyPackageName = Dependency.ToString();
+            if (DependencyPackageName.StartsWith(TEXT("/Script/")))
+            {
+                OutSeedObjectPaths.Add(MoveTemp(DependencyPackageName));
+            }
+        }
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Gathered %d reachability seed types and script packages from %d project assets"), OutSeedObjectPaths.Num(), ProjectAssets.Num());
+}
+
+bool FSuziePluginModule::IsAlwaysGeneratedType(const FString& ObjectPath)
+{
+    for (const FString& AlwaysGeneratedTypeEntry : GetDefault<USuzieSettings>()->AlwaysGeneratedTypes)
+    {
+        if (MatchesObjectPathPattern(ObjectPath, AlwaysGeneratedTypeEntry))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FSuziePluginModule::GatherReachableObjectPaths(const TSet<FString>& SeedObjectPaths, TFunctionRef<TSharedPtr<FJsonObject>(const FString&)> FindDefinition, TSet<FString>& OutReachableObjectPaths)
+{
+    TArray<TPair<FString, TSharedPtr<FJsonObject>>> PendingObjects;
+    auto MarkObjectReachable = [&](const FString& ObjectPath)
+    {
+        // Only objects in the dumps are of interest, other references are native types
+        if (OutReachableObjectPaths.Contains(ObjectPath))
+        {
+            return;
+        }
+        if (TSharedPtr<FJsonObject> ObjectDefinition = FindDefinition(ObjectPath))
+        {
+            OutReachableObjectPaths.Add(ObjectPath);
+            PendingObjects.Add({ObjectPath, MoveTemp(ObjectDefinition)});
+        }
+    };
+    for (const FString& SeedObjectPath : SeedObjectPaths)
+    {
+        MarkObjectReachable(SeedObjectPath);
+    }
+
+    // Follow super structs, property types, function signatures, subobject classes and default values until there is nothing new left
+    while (!PendingObjects.IsEmpty())
+    {
+        const TPair<FString, TSharedPtr<FJsonObject>> PendingObject = PendingObjects.Pop();
+        FSuzieObjectReferenceHelper::ForEachReferencedObjectPath(PendingObject.Key, PendingObject.Value, MarkObjectReachable);
+    }
+}
+
+void FSuziePluginModule::PruneUnreachableObjects(const TSharedPtr<FJsonObject>& RootObject, const TSet<FString>& SeedObjectPaths)
+{
+    const TSharedPtr<FJsonObject>* Objects;
+    if (!RootObject->TryGetObjectField(TEXT("objects"), Objects))
+    {
+        return;
+    }
+    TMap<FString, TSharedPtr<FJsonValue>>& ObjectMap = (*Objects)->Values;
+
+    // Seed package names stand for every object inside the package
+    TSet<FString> AllSeedObjectPaths = SeedObjectPaths;
+    for (const auto& [ObjectPath, ObjectValue] : ObjectMap)
+    {
+        if (IsObjectInPackages(ObjectPath, &SeedObjectPaths) || IsAlwaysGeneratedType(ObjectPath))
+        {
+            AllSeedObjectPaths.Add(ObjectPath);
+        }
+    }
+    TSet<FString> ReachableObjectPaths;
+    GatherReachableObjectPaths(AllSeedObjectPaths, [&](const FString& ObjectPath)
+    {
+        const TSharedPtr<FJsonValue>* ObjectValue = ObjectMap.Find(ObjectPath);
+        return ObjectValue ? (*ObjectValue)->AsObject() : nullptr;
+    }, ReachableObjectPaths);
+
+    // Drop everything else so it is neither generated nor kept in memory
+    const int32 TotalObjectCount = ObjectMap.Num();
+    for (auto It = ObjectMap.CreateIterator(); It; ++It)
+    {
+        if (!ReachableObjectPaths.Contains(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Reachability pruning kept %d out of %d objects"), ObjectMap.Num(), TotalObjectCount);
+}
@@ -0,0 +1,21 @@
+#include "SuzieSettings.h"
+
+USuzieSettings::USuzieSettings()
+{
+    bHotReloadChangedDumps = true;
+    HotReloadDelay = 1.0f;
+    bSkipObjectsInNativePackages = true;
+    bDeferClassFunctions = false;
+    bUseDumpSnapshot = true;
+    bOnlyGenerateReachableTypes = false;
+    bStreamDumps = false;
+    StreamingMemoryCeilingMB = 512;
+    bWriteGenerationProfile = true;
+    NumProfiledMostExpensiveTypes = 20;
+    GenerationRegressionThresholdPercent = 0.0f;
+}
+
+FName USuzieSettings::GetCategoryName() const
+{
+    return TEXT("Plugins");
+}
@@ -0,0 +1,234 @@
+#include "SuziePlugin.h"
+#include "SuzieSettings.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// Returns the name of the package the object is in, or an empty string if the path has no package separator
+static FString GetPackageNameFromObjectPath(const FString& ObjectPath)
+{
+    int32 PackageNameSeparatorIndex;
+    return ObjectPath.FindChar('.', PackageNameSeparatorIndex) ? ObjectPath.Left(PackageNameSeparatorIndex) : FString();
+}
+
+// Returns true if the pattern could match objects in the package. Wildcards are only compared up to their first wildcard character, so this can give false positives
+static bool CanPatternMatchObjectsInPackage(const FString& PackageName, const FString& Pattern)
+{
+    int32 WildcardIndex = INDEX_NONE;
+    for (int32 CharIndex = 0; CharIndex < Pattern.Len(); CharIndex++)
+    {
+        if (Pattern[CharIndex] == '*' || Pattern[CharIndex] == '?')
+        {
+            WildcardIndex = CharIndex;
+            break;
+        }
+    }
+    const FString PackagePrefix = PackageName + TEXT(".");
+    if (WildcardIndex == INDEX_NONE)
+    {
+        return Pattern == PackageName || Pattern.StartsWith(PackagePrefix);
+    }
+    const FString PatternPrefix = Pattern.Left(WildcardIndex);
+    return PackagePrefix.StartsWith(PatternPrefix) || PatternPrefix.StartsWith(PackagePrefix);
+}
+
+bool FSuziePluginModule::IsJsonClassDefinitionShardIndexFile(const FString& JsonFileName)
+{
+    return JsonFileName.EndsWith(TEXT(".jmapindex"));
+}
+
+bool FSuziePluginModule::LoadJsonClassDefinitionShardIndex(const FString& IndexFilePath, const FString& DumpName, TArray<FString>& OutShardFilePaths)
+{
+    FString IndexContent;
+    if (!FFileHelper::LoadFileToString(IndexContent, *IndexFilePath))
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to read shard index: %s"), *IndexFilePath);
+        return false;
+    }
+    TSharedPtr<FJsonObject> IndexRootObject;
+    const TSharedRef<TJsonReader<TCHAR>> IndexReader = TJsonReaderFactory<TCHAR>::Create(IndexContent);
+    const TSharedPtr<FJsonObject>* Packages;
+    if (!FJsonSerializer::Deserialize(IndexReader, IndexRootObject) || !IndexRootObject.IsValid() || !IndexRootObject->TryGetObjectField(TEXT("packages"), Packages))
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to parse shard index: %s"), *IndexFilePath);
+        return false;
+    }
+
+    // Shard paths in the index are relative to the directory of the index
+    const FString IndexDirectory = FPaths::GetPath(IndexFilePath);
+    TSet<FString> ShardFilePaths;
+    for (const auto& [PackageName, PackageValue] : (*Packages)->Values)
+    {
+        const TSharedPtr<FJsonObject> PackageObject = PackageValue->AsObject();
+        FString ShardFileName;
+        if (!PackageObject.IsValid() || !PackageObject->TryGetStringField(TEXT("shard"), ShardFileName))
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("Package %s in shard index %s has no shard"), *PackageName, *FPaths::GetCleanFilename(IndexFilePath));
+            continue;
+        }
+        // Same as with regular dumps, packages present in multiple sharded dumps are taken from the first one
+        if (DumpShardFilePathByPackageName.Contains(PackageName))
+        {
+            continue;
+        }
+        const FString ShardFilePath = FPaths::ConvertRelativePathToFull(IndexDirectory / ShardFileName);
+        DumpShardFilePathByPackageName.Add(PackageName, ShardFilePath);
+        DumpShardDumpNames.Add(ShardFilePath, DumpName);
+        ShardFilePaths.Add(ShardFilePath);
+
+        const TArray<TSharedPtr<FJsonValue>>* Dependencies;
+        if (PackageObject->TryGetArrayField(TEXT("dependencies"), Dependencies))
+        {
+            TArray<FString>& PackageDependencies = DumpShardPackageDependencies.FindOrAdd(PackageName);
+            for (const TSharedPtr<FJsonValue>& Dependency : *Dependencies)
+            {
+                PackageDependencies.Add(Dependency->AsString());
+            }
+        }
+    }
+    OutShardFilePaths = ShardFilePaths.Array();
+    OutShardFilePaths.Sort();
+    return true;
+}
+
+bool FSuziePluginModule::LoadShardedJsonClassDefinitions(const FString& IndexFilePath, const TSet<FString>* ReachabilitySeedObjectPaths, const TSet<FString>& PreviouslyLoadedShardFilePaths, TSharedPtr<FJsonObject>& OutRootObject)
+{
+    TArray<FString> AllShardFilePaths;
+    if (!LoadJsonClassDefinitionShardIndex(IndexFilePath, GetJsonClassDefinitionDumpName(FPaths::GetCleanFilename(IndexFilePath)), AllShardFilePaths))
+    {
+        return false;
+    }
+
+    // Without reachability analysis every type is generated, so every shard is needed
+    TArray<FString> ShardFilePathsToLoad;
+    if (ReachabilitySeedObjectPaths == nullptr)
+    {
+        ShardFilePathsToLoad = AllShardFilePaths;
+    }
+    else
+    {
+        const TSet<FString> IndexShardFilePaths(AllShardFilePaths);
+        TSet<FString> NeededPackageNames;
+        TArray<FString> PendingPackageNames;
+        auto MarkPackageNeeded = [&](const FString& PackageName)
+        {
+            const FString* ShardFilePath = DumpShardFilePathByPackageName.Find(PackageName);
+            if (ShardFilePath && IndexShardFilePaths.Contains(*ShardFilePath) && !SkippedPackageNames.Contains(PackageName) && !NeededPackageNames.Contains(PackageName))
+            {
+                NeededPackageNames.Add(PackageName);
+                PendingPackageNames.Add(PackageName);
+            }
+        };
+
+        // Packages of the seed types, seed packages and the always generated types, and everything they depend on according to the index
+        for (const FString& SeedObjectPath : *ReachabilitySeedObjectPaths)
+        {
+            MarkPackageNeeded(SeedObjectPath.Contains(TEXT(".")) ? GetPackageNameFromObjectPath(SeedObjectPath) : SeedObjectPath);
+        }
+        for (const auto& [PackageName, ShardFilePath] : DumpShardFilePathByPackageName)
+        {
+            const bool bPackageLoadedBefore = PreviouslyLoadedShardFilePaths.Contains(ShardFilePath);
+            if (bPackageLoadedBefore || GetDefault<USuzieSettings>()->AlwaysGeneratedTypes.ContainsByPredicate([&](const FString& Pattern) { return CanPatternMatchObjectsInPackage(PackageName, Pattern); }))
+            {
+                MarkPackageNeeded(PackageName);
+            }
+        }
+        while (!PendingPackageNames.IsEmpty())
+        {
+            if (const TArray<FString>* Dependencies = DumpShardPackageDependencies.Find(PendingPackageNames.Pop()))
+            {
+                for (const FString& Dependency : *Dependencies)
+                {
+                    MarkPackageNeeded(Dependency);
+                }
+            }
+        }
+
+        TSet<FString> NeededShardFilePaths;
+        for (const FString& PackageName : NeededPackageNames)
+        {
+            NeededShardFilePaths.Add(DumpShardFilePathByPackageName.FindChecked(PackageName));
+        }
+        ShardFilePathsToLoad = NeededShardFilePaths.Array();
+        ShardFilePathsToLoad.Sort();
+    }
+
+    // Shards are independent files, so they are read, decompressed and parsed in parallel
+    TArray<TSharedPtr<FJsonObject>> ShardRootObjects;
+    TArray<TSet<FString>> ShardSkippedObjectPaths;
+    ShardRootObjects.SetNum(ShardFilePathsToLoad.Num());
+    ShardSkippedObjectPaths.SetNum(ShardFilePathsToLoad.Num());
+    ParallelFor(ShardFilePathsToLoad.Num(), [&](const int32 ShardIndex)
+    {
+        if (!LoadJsonClassDefinitionFile(ShardFilePathsToLoad[ShardIndex], ShardRootObjects[ShardIndex], &SkippedPackageNames, &ShardSkippedObjectPaths[ShardIndex]))
+        {
+            ShardRootObjects[ShardIndex].Reset();
+        }
+    });
+
+    // Shards are merged in the order of their file names, so the result does not depend on the order the loads finished in
+    TSharedPtr<FJsonObject> MergedObjects = MakeShared<FJsonObject>();
+    for (int32 ShardIndex = 0; ShardIndex < ShardFilePathsToLoad.Num(); ShardIndex++)
+    {
+        LoadedDumpShardFilePaths.Add(ShardFilePathsToLoad[ShardIndex]);
+        SkippedObjectPaths.Append(MoveTemp(ShardSkippedObjectPaths[ShardIndex]));
+
+        const TSharedPtr<FJsonObject>* Objects;
+        if (ShardRootObjects[ShardIndex].IsValid() && ShardRootObjects[ShardIndex]->TryGetObjectField(TEXT("objects"), Objects))
+        {
+            MergeJsonClassDefinitionObjects(MergedObjects->Values, MoveTemp((*Objects)->Values), FPaths::GetCleanFilename(ShardFilePathsToLoad[ShardIndex]));
+        }
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Loaded %d out of %d shards of %s"), ShardFilePathsToLoad.Num(), AllShardFilePaths.Num(), *FPaths::GetCleanFilename(IndexFilePath));
+
+    OutRootObject = MakeShared<FJsonObject>();
+    OutRootObject->SetObjectField(TEXT("objects"), MergedObjects);
+    return true;
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::LoadObjectDefinitionFromShard(const FString& ObjectPath)
+{
+    if (OnDemandShardObjects.IsValid())
+    {
+        if (const TSharedPtr<FJsonValue>* ObjectValue = OnDemandShardObjects->Values.Find(ObjectPath))
+        {
+            return (*ObjectValue)->AsObject();
+        }
+    }
+
+    // Each shard is only loaded once, so objects that are not in their shard are not looked up again
+    const FString PackageName = GetPackageNameFromObjectPath(ObjectPath);
+    const FString* ShardFilePath = DumpShardFilePathByPackageName.Find(PackageName);
+    if (ShardFilePath == nullptr || LoadedDumpShardFilePaths.Contains(*ShardFilePath) || SkippedPackageNames.Contains(PackageName))
+    {
+        return nullptr;
+    }
+    LoadedDumpShardFilePaths.Add(*ShardFilePath);
+
+    UE_LOG(LogSuzie, Display, TEXT("Loading shard %s on demand for %s"), *FPaths::GetCleanFilename(*ShardFilePath), *ObjectPath);
+    TSharedPtr<FJsonObject> ShardRootObject;
+    const TSharedPtr<FJsonObject>* Objects;
+    if (!LoadJsonClassDefinitionFile(*ShardFilePath, ShardRootObject, &SkippedPackageNames, &SkippedObjectPaths) || !ShardRootObject->TryGetObjectField(TEXT("objects"), Objects))
+    {
+        return nullptr;
+    }
+    if (const TArray<TSharedPtr<FJsonObject>>* Overlays = ShardedDumpOverlays.Find(DumpShardDumpNames.FindRef(*ShardFilePath)))
+    {
+        for (const TSharedPtr<FJsonObject>& Overlay : *Overlays)
+        {
+            ApplyJsonClassDefinitionOverlay(ShardRootObject, Overlay, false);
+        }
+    }
+
+    if (!OnDemandShardObjects.IsValid())
+    {
+        OnDemandShardObjects = MakeShared<FJsonObject>();
+    }
+    MergeJsonClassDefinitionObjects(OnDemandShardObjects->Values, MoveTemp((*Objects)->Values), FPaths::GetCleanFilename(*ShardFilePath));
+
+    const TSharedPtr<FJsonValue>* ObjectValue = OnDemandShardObjects->Values.Find(ObjectPath);
+    return ObjectValue ? (*ObjectValue)->AsObject() : nullptr;
+}
@@ -0,0 +1,437 @@
+#include "SuzieStreamedDumpIndex.h"
+#include "SuzieDecompressionHelper.h"
+#include "SuzieTrace.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// Parsed JSON values take several times the size of their text. This is a rough estimate used to keep the cache within its memory ceiling
+static constexpr int64 ParsedDefinitionSizeFactor = 8;
+
+FSuzieStreamedDumpIndex::FSuzieStreamedDumpIndex(const FString& InDumpTextDirectory, const int64 InMaxCachedDefinitionBytes) :
+    DumpTextDirectory(InDumpTextDirectory), MaxCachedDefinitionBytes(InMaxCachedDefinitionBytes)
+{
+}
+
+FSuzieStreamedDumpIndex::~FSuzieStreamedDumpIndex()
+{
+    // Files have to be closed before they can be deleted. Uncompressed dumps are read in place, so only the decompressed copies are deleted
+    DumpTextFiles.Empty();
+    for (const FString& DumpTextFilePath : TemporaryDumpTextFilePaths)
+    {
+        IFileManager::Get().Delete(*DumpTextFilePath, false, true, true);
+    }
+}
+
+// Reads the text of a dump through a small window that moves forward with the position, so that indexing never holds the entire text in memory
+class FSuzieStreamedDumpIndex::FDumpTextReader
+{
+public:
+    explicit FDumpTextReader(IFileHandle& InFile) : File(InFile), Size(InFile.Size())
+    {
+    }
+
+    /** Returns true if there is a character at the position */
+    bool IsValidPosition(const int64 Position) const { return Position < Size && !bReadFailed; }
+    /** Returns the character at the position, or 0 if the position is out of range or the text could not be read */
+    uint8 operator[](const int64 Position)
+    {
+        if (Position < WindowStart || Position >= WindowStart + Window.Num())
+        {
+            const int64 WindowSize = FMath::Min<int64>(TextWindowSize, Size - Position);
+            Window.SetNumUninitialized((int32)FMath::Max<int64>(WindowSize, 0));
+            WindowStart = Position;
+            if (WindowSize <= 0 || !File.Seek(Position) || !File.Read(Window.GetData(), WindowSize))
+            {
+                bReadFailed = true;
+                Window.Reset();
+                return 0;
+            }
+        }
+        return Window[Position - WindowStart];
+    }
+    /** Reads the text between the positions, which does not have to be inside of the window */
+    bool ReadText(const int64 StartPosition, const int64 EndPosition, TArray<uint8>& OutText)
+    {
+        OutText.SetNumUninitialized((int32)(EndPosition - StartPosition));
+        return File.Seek(StartPosition) && File.Read(OutText.GetData(), OutText.Num());
+    }
+    int64 GetSize() const { return Size; }
+private:
+    static constexpr int64 TextWindowSize = 1024 * 1024;
+
+    IFileHandle& File;
+    int64 Size{};
+    TArray<uint8> Window;
+    int64 WindowStart{};
+    bool bReadFailed{};
+};
+
+bool FSuzieStreamedDumpIndex::AddDumpFile(const FString& FilePath, TFunctionRef<bool(const FString&)> ShouldSkipObject, TSet<FString>& OutSkippedObjectPaths, FString& OutErrorMessage)
+{
+    SUZIE_TRACE_SCOPE(IndexDump);
+    const int32 DumpIndex = DumpTextFiles.Num();
+
+    // Uncompressed dumps are indexed and read in place. Compressed dumps are decompressed as a stream into a temporary file,
+    // so neither the compressed nor the decompressed dump is ever held in memory
+    FString DumpTextFilePath = FilePath;
+    if (FSuzieDecompressionHelper::IsCompressedFileName(FilePath))
+    {
+        SUZIE_TRACE_SCOPE(DecompressDump);
+        DumpTextFilePath = DumpTextDirectory / FString::Printf(TEXT("Dump%d.json"), DumpIndex);
+        const TUniquePtr<FArchive> DumpTextWriter(IFileManager::Get().CreateFileWriter(*DumpTextFilePath));
+        const bool bDecompressed = DumpTextWriter.IsValid() && FSuzieDecompressionHelper::DecompressFileToArchive(FilePath, *DumpTextWriter) && DumpTextWriter->Close();
+        TemporaryDumpTextFilePaths.Add(DumpTextFilePath);
+        if (!bDecompressed)
+        {
+            OutErrorMessage = FString::Printf(TEXT("Failed to decompress the dump to %s"), *DumpTextFilePath);
+            return false;
+        }
+    }
+    TUniquePtr<IFileHandle> DumpTextFile(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*DumpTextFilePath));
+    if (!DumpTextFile.IsValid())
+    {
+        OutErrorMessage = FString::Printf(TEXT("Failed to open %s"), *DumpTextFilePath);
+        return false;
+    }
+    FDumpTextReader Data(*DumpTextFile);
+
+    // Byte order mark is optional in UTF-8 files
+    int64 Position = 0;
+    if (Data.GetSize() >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+    {
+        Position = 3;
+    }
+    if (!SkipWhitespace(Data, Position) || Data[Position] != '{')
+    {
+        OutErrorMessage = TEXT("Root value is not an object. Streamed dumps must be UTF-8 encoded");
+        return false;
+    }
+    Position++;
+
+    // Spans are only added to the index once the entire dump has been scanned successfully, since they point into the dump text
+    TArray<TPair<FString, FObjectSpan>> NewObjectSpans;
+    auto ReportSyntaxError = [&]()
+    {
+        OutErrorMessage = FString::Printf(TEXT("Invalid JSON at byte %lld"), Position);
+        return false;
+    };
+    while (true)
+    {
+        if (!SkipWhitespace(Data, Position))
+        {
+            return ReportSyntaxError();
+        }
+        if (Data[Position] == '}')
+        {
+            break;
+        }
+        FString FieldName;
+        if (!ReadString(Data, Position, &FieldName) || !SkipWhitespace(Data, Position) || Data[Position] != ':')
+        {
+            return ReportSyntaxError();
+        }
+        Position++;
+        if (!SkipWhitespace(Data, Position))
+        {
+            return ReportSyntaxError();
+        }
+
+        if (FieldName == TEXT("objects") && Data[Position] == '{')
+        {
+            Position++;
+            while (true)
+            {
+                if (!SkipWhitespace(Data, Position))
+                {
+                    return ReportSyntaxError();
+                }
+                if (Data[Position] == '}')
+                {
+                    Position++;
+                    break;
+                }
+                FString ObjectPath;
+                if (!ReadString(Data, Position, &ObjectPath) || !SkipWhitespace(Data, Position) || Data[Position] != ':')
+                {
+                    return ReportSyntaxError();
+                }
+                Position++;
+                if (!SkipWhitespace(Data, Position))
+                {
+                    return ReportSyntaxError();
+                }
+                const int64 ValueOffset = Position;
+                if (!SkipValue(Data, Position))
+                {
+                    return ReportSyntaxError();
+                }
+
+                if (ShouldSkipObject(ObjectPath))
+                {
+                    OutSkippedObjectPaths.Add(MoveTemp(ObjectPath));
+                }
+                else
+                {
+                    NewObjectSpans.Add({MoveTemp(ObjectPath), FObjectSpan{DumpIndex, ValueOffset, Position - ValueOffset}});
+                }
+                if (SkipWhitespace(Data, Position) && Data[Position] == ',')
+                {
+                    Position++;
+                }
+            }
+        }
+        else if (!SkipValue(Data, Position))
+        {
+            return ReportSyntaxError();
+        }
+        if (SkipWhitespace(Data, Position) && Data[Position] == ',')
+        {
+            Position++;
+        }
+    }
+
+    DumpTextFiles.Add(MoveTemp(DumpTextFile));
+    DumpDataSize += Data.GetSize();
+
+    ObjectSpans.Reserve(ObjectSpans.Num() + NewObjectSpans.Num());
+    for (TPair<FString, FObjectSpan>& NewObjectSpan : NewObjectSpans)
+    {
+        if (!ObjectSpans.Contains(NewObjectSpan.Key))
+        {
+            ObjectSpans.Add(MoveTemp(NewObjectSpan.Key), NewObjectSpan.Value);
+        }
+    }
+    return true;
+}
+
+void FSuzieStreamedDumpIndex::ApplyOverlay(const TSharedPtr<FJsonObject>& OverlayRootObject)
+{
+    const TArray<TSharedPtr<FJsonValue>>* RemovedObjectPaths;
+    if (OverlayRootObject->TryGetArrayField(TEXT("removed_objects"), RemovedObjectPaths))
+    {
+        for (const TSharedPtr<FJsonValue>& RemovedObjectPathValue : *RemovedObjectPaths)
+        {
+            const FString RemovedObjectPath = RemovedObjectPathValue->AsString();
+            ObjectSpans.Remove(RemovedObjectPath);
+            OverlayObjects.Remove(RemovedObjectPath);
+            FCachedDefinition CachedDefinition;
+            if (CachedDefinitions.RemoveAndCopyValue(RemovedObjectPath, CachedDefinition))
+            {
+                CachedDefinitionBytes -= CachedDefinition.Cost;
+            }
+        }
+    }
+    // Overlay objects are already parsed and small, so they are kept outside of the cache
+    const TSharedPtr<FJsonObject>* Objects;
+    if (OverlayRootObject->TryGetObjectField(TEXT("objects"), Objects))
+    {
+        for (const auto& [ObjectPath, ObjectValue] : (*Objects)->Values)
+        {
+            OverlayObjects.Add(ObjectPath, ObjectValue->AsObject());
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FSuzieStreamedDumpIndex::FindObjectDefinition(const FString& ObjectPath)
+{
+    if (const TSharedPtr<FJsonObject>* OverlayObject = OverlayObjects.Find(ObjectPath))
+    {
+        return *OverlayObject;
+    }
+    if (FCachedDefinition* CachedDefinition = CachedDefinitions.Find(ObjectPath))
+    {
+        CachedDefinition->LastUseIndex = NextUseIndex++;
+        return CachedDefinition->Definition;
+    }
+    const FObjectSpan* ObjectSpan = ObjectSpans.Find(ObjectPath);
+    if (ObjectSpan == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Only the text of this object is read, converted and parsed
+    SUZIE_TRACE_SCOPE(ParseStreamedDefinition);
+    IFileHandle& DumpTextFile = *DumpTextFiles[ObjectSpan->DumpIndex];
+    TArray<uint8> ObjectText;
+    ObjectText.SetNumUninitialized((int32)ObjectSpan->Size);
+    if (!DumpTextFile.Seek(ObjectSpan->Offset) || !DumpTextFile.Read(ObjectText.GetData(), ObjectSpan->Size))
+    {
+        return nullptr;
+    }
+    const FUTF8ToTCHAR ObjectTextConverter(reinterpret_cast<const ANSICHAR*>(ObjectText.GetData()), ObjectText.Num());
+    TSharedPtr<FJsonObject> Definition;
+    const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FString(ObjectTextConverter.Length(), ObjectTextConverter.Get()));
+    if (!FJsonSerializer::Deserialize(Reader, Definition) || !Definition.IsValid())
+    {
+        return nullptr;
+    }
+    NumParsedDefinitions++;
+
+    const int64 Cost = ObjectSpan->Size * ParsedDefinitionSizeFactor;
+    CachedDefinitions.Add(ObjectPath, FCachedDefinition{Definition, Cost, NextUseIndex++});
+    CachedDefinitionBytes += Cost;
+    PeakCachedDefinitionBytes = FMath::Max(PeakCachedDefinitionBytes, CachedDefinitionBytes);
+    if (CachedDefinitionBytes > MaxCachedDefinitionBytes)
+    {
+        ReleaseLeastRecentlyUsedDefinitions();
+    }
+    // Callers keep their own reference, so the definition stays valid even if it has just been released from the cache
+    return Definition;
+}
+
+TArray<FString> FSuzieStreamedDumpIndex::GetObjectPaths() const
+{
+    TArray<FString> ObjectPaths;
+    ObjectPaths.Reserve(ObjectSpans.Num() + OverlayObjects.Num());
+    for (const auto& [ObjectPath, ObjectSpan] : ObjectSpans)
+    {
+        ObjectPaths.Add(ObjectPath);
+    }
+    for (const auto& [ObjectPath, OverlayObject] : OverlayObjects)
+    {
+        if (!ObjectSpans.Contains(ObjectPath))
+        {
+            ObjectPaths.Add(ObjectPath);
+        }
+    }
+    return ObjectPaths;
+}
+
+void FSuzieStreamedDumpIndex::ReleaseLeastRecentlyUsedDefinitions()
+{
+    // Definitions are released until a quarter of the ceiling is free, so that the sorting is not repeated for every parsed definition
+    TArray<TPair<uint64, FString>> DefinitionsByLastUse;
+    DefinitionsByLastUse.Reserve(CachedDefinitions.Num());
+    for (const auto& [ObjectPath, CachedDefinition] : CachedDefinitions)
+    {
+        DefinitionsByLastUse.Add({CachedDefinition.LastUseIndex, ObjectPath});
+    }
+    DefinitionsByLastUse.Sort([](const TPair<uint64, FString>& A, const TPair<uint64, FString>& B) { return A.Key < B.Key; });
+
+    const int64 TargetCachedDefinitionBytes = MaxCachedDefinitionBytes * 3 / 4;
+    for (const TPair<uint64, FString>& Definition : DefinitionsByLastUse)
+    {
+        if (CachedDefinitionBytes <= TargetCachedDefinitionBytes)
+        {
+            break;
+        }
+        FCachedDefinition CachedDefinition;
+        CachedDefinitions.RemoveAndCopyValue(Definition.Value, CachedDefinition);
+        CachedDefinitionBytes -= CachedDefinition.Cost;
+    }
+}
+
+bool FSuzieStreamedDumpIndex::SkipWhitespace(FDumpTextReader& Data, int64& Position)
+{
+    while (Data.IsValidPosition(Position) && (Data[Position] == ' ' || Data[Position] == '\t' || Data[Position] == '\r' || Data[Position] == '\n'))
+    {
+        Position++;
+    }
+    return Data.IsValidPosition(Position);
+}
+
+bool FSuzieStreamedDumpIndex::ReadString(FDumpTextReader& Data, int64& Position, FString* OutString)
+{
+    if (!Data.IsValidPosition(Position) || Data[Position] != '"')
+    {
+        return false;
+    }
+    const int64 StartPosition = Position;
+    bool bHasEscapeSequences = false;
+    for (Position++; Data.IsValidPosition(Position); Position++)
+    {
+        if (Data[Position] == '\\')
+        {
+            bHasEscapeSequences = true;
+            Position++;
+        }
+        else if (Data[Position] == '"')
+        {
+            break;
+        }
+    }
+    if (!Data.IsValidPosition(Position))
+    {
+        return false;
+    }
+    Position++;
+
+    if (OutString != nullptr)
+    {
+        TArray<uint8> StringData;
+        if (!Data.ReadText(StartPosition, Position, StringData))
+        {
+            return false;
+        }
+        // Object paths rarely contain escape sequences, let the JSON reader handle them when they do
+        const ANSICHAR* StringText = reinterpret_cast<const ANSICHAR*>(StringData.GetData());
+        if (!bHasEscapeSequences)
+        {
+            const FUTF8ToTCHAR UnquotedText(StringText + 1, StringData.Num() - 2);
+            *OutString = FString(UnquotedText.Length(), UnquotedText.Get());
+        }
+        else
+        {
+            const FUTF8ToTCHAR QuotedText(StringText, StringData.Num());
+            TArray<TSharedPtr<FJsonValue>> StringValues;
+            const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(TEXT("[") + FString(QuotedText.Length(), QuotedText.Get()) + TEXT("]"));
+            if (!FJsonSerializer::Deserialize(Reader, StringValues) || StringValues.Num() != 1)
+            {
+                return false;
+            }
+            *OutString = StringValues[0]->AsString();
+        }
+    }
+    return true;
+}
+
+bool FSuzieStreamedDumpIndex::SkipValue(FDumpTextReader& Data, int64& Position)
+{
+    if (!Data.IsValidPosition(Position))
+    {
+        return false;
+    }
+    if (Data[Position] == '"')
+    {
+        return ReadString(Data, Position, nullptr);
+    }
+    if (Data[Position] == '{' || Data[Position] == '[')
+    {
+        // Strings are skipped separately, so brackets inside of them are not counted
+        int32 Depth = 0;
+        while (Data.IsValidPosition(Position))
+        {
+            const uint8 Character = Data[Position];
+            if (Character == '"')
+            {
+                if (!ReadString(Data, Position, nullptr))
+                {
+                    return false;
+                }
+                continue;
+            }
+            if (Character == '{' || Character == '[')
+            {
+                Depth++;
+            }
+            else if ((Character == '}' || Character == ']') && --Depth == 0)
+            {
+                Position++;
+                return true;
+            }
+            Position++;
+        }
+        return false;
+    }
+    // Numbers, booleans and null end at the next delimiter
+    while (Data.IsValidPosition(Position) && Data[Position] != ',' && Data[Position] != '}' && Data[Position] != ']' &&
+        Data[Position] != ' ' && Data[Position] != '\t' && Data[Position] != '\r' && Data[Position] != '\n')
+    {
+        Position++;
+    }
+    return true;
+}
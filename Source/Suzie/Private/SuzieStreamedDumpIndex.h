@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class IFileHandle;
+
+// Index of the objects in the dumps that keeps only the position of each object in the UTF-8 text. Uncompressed dumps are read in place, and compressed
+// dumps are decompressed into temporary files. Definitions are read from the files and parsed when they are looked up, and the least recently used
+// definitions are released once they use more memory than allowed
+class FSuzieStreamedDumpIndex
+{
+public:
+    FSuzieStreamedDumpIndex(const FString& InDumpTextDirectory, int64 InMaxCachedDefinitionBytes);
+    ~FSuzieStreamedDumpIndex();
+
+    /** Indexes the objects of the UTF-8 dump file without parsing them or loading the file into memory. Objects indexed from an earlier dump are kept, the same as when the dumps are merged */
+    bool AddDumpFile(const FString& FilePath, TFunctionRef<bool(const FString&)> ShouldSkipObject, TSet<FString>& OutSkippedObjectPaths, FString& OutErrorMessage);
+    /** Objects of the overlay replace the indexed objects with the same path, and removed objects can no longer be found */
+    void ApplyOverlay(const TSharedPtr<FJsonObject>& OverlayRootObject);
+
+    /** Returns the parsed definition of the object, or nullptr if the object is not in the dumps */
+    TSharedPtr<FJsonObject> FindObjectDefinition(const FString& ObjectPath);
+    /** Returns paths of all indexed objects in the order they have been indexed in */
+    TArray<FString> GetObjectPaths() const;
+
+    int64 GetDumpDataSize() const { return DumpDataSize; }
+    int32 GetNumParsedDefinitions() const { return NumParsedDefinitions; }
+    int64 GetPeakCachedDefinitionBytes() const { return PeakCachedDefinitionBytes; }
+private:
+    struct FObjectSpan
+    {
+        int32 DumpIndex{};
+        int64 Offset{};
+        int64 Size{};
+    };
+    struct FCachedDefinition
+    {
+        TSharedPtr<FJsonObject> Definition;
+        int64 Cost{};
+        uint64 LastUseIndex{};
+    };
+
+    class FDumpTextReader;
+
+    static bool SkipWhitespace(FDumpTextReader& Data, int64& Position);
+    static bool ReadString(FDumpTextReader& Data, int64& Position, FString* OutString);
+    static bool SkipValue(FDumpTextReader& Data, int64& Position);
+    void ReleaseLeastRecentlyUsedDefinitions();
+
+    FString DumpTextDirectory;
+    TArray<FString> TemporaryDumpTextFilePaths;
+    TArray<TUniquePtr<IFileHandle>> DumpTextFiles;
+    int64 DumpDataSize{};
+    TMap<FString, FObjectSpan> ObjectSpans;
+    TMap<FString, TSharedPtr<FJsonObject>> OverlayObjects;
+    TMap<FString, FCachedDefinition> CachedDefinitions;
+    int64 CachedDefinitionBytes{};
+    int64 MaxCachedDefinitionBytes{};
+    int64 PeakCachedDefinitionBytes{};
+    uint64 NextUseIndex{};
+    int32 NumParsedDefinitions{};
+};
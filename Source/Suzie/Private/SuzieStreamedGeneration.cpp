@@ -0,0 +1,132 @@
+#include "SuziePlugin.h"
+#include "SuzieSettings.h"
+#include "SuzieStreamedDumpIndex.h"
+#include "SuzieTrace.h"
+#include "SuzieGenerationProfile.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+
+#define LOCTEXT_NAMESPACE "FSuziePluginModule"
+
+void FSuziePluginModule::CreateDynamicClassesFromStreamedDumps(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, FScopedSlowTask& SlowTask)
+{
+    const USuzieSettings* Settings = GetDefault<USuzieSettings>();
+    const FString JsonClassesPath = GetJsonClassDefinitionsDirectory();
+    StreamedDumpIndex = MakeShared<FSuzieStreamedDumpIndex>(FPaths::ProjectSavedDir() / TEXT("Suzie") / TEXT("StreamedDumps"), static_cast<int64>(Settings->StreamingMemoryCeilingMB) * 1024 * 1024);
+
+    SlowTask.EnterProgressFrame(1, LOCTEXT("LoadingOverlays", "Loading overlays"));
+    TMap<FString, TArray<TSharedPtr<FJsonObject>>> OverlaysByDumpName;
+    LoadJsonClassDefinitionOverlays(OverlayFileNames, OverlaysByDumpName);
+
+    {
+        FSuzieGenerationProfile::FScopedPhase IndexDumpsPhase(GenerationProfile.Get(), TEXT("IndexDumps"));
+        for (const FString& JsonFileName : DumpFileNames)
+        {
+            SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("IndexingJsonFile", "Indexing {0}"), FText::AsCultureInvariant(JsonFileName)));
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+            SlowTask.ForceRefresh();
+#endif
+            UE_LOG(LogSuzie, Display, TEXT("Indexing JSON class definition: %s"), *JsonFileName);
+            FSuzieGenerationProfile::FScopedFile ProfileFile(GenerationProfile.Get(), JsonClassesPath / JsonFileName);
+
+            // Every shard of a sharded dump is indexed, since indexing does not parse the objects
+            const FString DumpName = GetJsonClassDefinitionDumpName(JsonFileName);
+            TArray<FString> FilePaths;
+            if (IsJsonClassDefinitionShardIndexFile(JsonFileName))
+            {
+                if (!LoadJsonClassDefinitionShardIndex(JsonClassesPath / JsonFileName, DumpName, FilePaths))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                FilePaths.Add(JsonClassesPath / JsonFileName);
+            }
+
+            for (const FString& FilePath : FilePaths)
+            {
+                FString ErrorMessage;
+                if (!StreamedDumpIndex->AddDumpFile(FilePath, [&](const FString& ObjectPath) { return IsObjectInPackages(ObjectPath, &SkippedPackageNames); }, SkippedObjectPaths, ErrorMessage))
+                {
+                    UE_LOG(LogSuzie, Error, TEXT("Failed to index %s: %s"), *FPaths::GetCleanFilename(FilePath), *ErrorMessage);
+                }
+            }
+
+            // Objects of the overlays replace objects indexed from any dump, not just their base dump. Objects present in multiple dumps have identical
+            // definitions in practice, so this only differs from regular generation for conflicting objects
+            TArray<TSharedPtr<FJsonObject>> Overlays;
+            if (OverlaysByDumpName.RemoveAndCopyValue(DumpName, Overlays))
+            {
+                for (const TSharedPtr<FJsonObject>& Overlay : Overlays)
+                {
+                    StreamedDumpIndex->ApplyOverlay(Overlay);
+                }
+            }
+        }
+    }
+
+    for (const auto& [DumpName, Overlays] : OverlaysByDumpName)
+    {
+        UE_LOG(LogSuzie, Warning, TEXT("Base dump %s not found, %d overlays referencing it have not been applied"), *DumpName, Overlays.Num());
+    }
+
+    // Only the types needed by the project are parsed at all when reachability is enabled
+    TArray<FString> ObjectPaths = StreamedDumpIndex->GetObjectPaths();
+    const int32 TotalObjectCount = ObjectPaths.Num();
+    if (Settings->bOnlyGenerateReachableTypes)
+    {
+        TSet<FString> SeedObjectPaths;
+        GatherReachableTypeSeeds(SeedObjectPaths);
+        // Seed package names stand for every object inside the package
+        const TSet<FString> SeedPackageNames = SeedObjectPaths;
+        for (const FString& ObjectPath : ObjectPaths)
+        {
+            if (IsObjectInPackages(ObjectPath, &SeedPackageNames) || IsAlwaysGeneratedType(ObjectPath))
+            {
+                SeedObjectPaths.Add(ObjectPath);
+            }
+        }
+        TSet<FString> ReachableObjectPaths;
+        GatherReachableObjectPaths(SeedObjectPaths, [&](const FString& ObjectPath) { return StreamedDumpIndex->FindObjectDefinition(ObjectPath); }, ReachableObjectPaths);
+        ObjectPaths.RemoveAll([&](const FString& ObjectPath) { return !ReachableObjectPaths.Contains(ObjectPath); });
+        UE_LOG(LogSuzie, Display, TEXT("Reachability pruning kept %d out of %d objects"), ObjectPaths.Num(), TotalObjectCount);
+    }
+
+    SlowTask.EnterProgressFrame(1, LOCTEXT("GeneratingClasses", "Generating classes"));
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+    SlowTask.ForceRefresh();
+#endif
+
+    // Nothing is in the global object map, every definition comes from the index
+    FDynamicClassGenerationContext ClassGenerationContext;
+    ClassGenerationContext.GlobalObjectMap = MakeShared<FJsonObject>();
+    ClassGenerationContext.SkippedObjectPaths = &SkippedObjectPaths;
+    SetupOnDemandObjectDefinitions(ClassGenerationContext);
+    // Deferred functions would need the definitions of all classes to be kept until they are created
+    ClassGenerationContext.bDeferClassFunctions = false;
+
+    {
+        FSuzieGenerationProfile::FScopedPhase CreateTypesPhase(GenerationProfile.Get(), TEXT("CreateTypes"));
+        SUZIE_TRACE_SCOPE(CreateTypes);
+        SUZIE_TRACE_PHASE_MEMORY_SCOPE(SuzieGenerationPhaseMemory);
+        for (const FString& ObjectPath : ObjectPaths)
+        {
+            if (const TSharedPtr<FJsonObject> ObjectDefinition = StreamedDumpIndex->FindObjectDefinition(ObjectPath))
+            {
+                CreateDynamicTypeForObject(ClassGenerationContext, ObjectPath, ObjectDefinition);
+            }
+        }
+    }
+    FinishCreatingDynamicClasses(ClassGenerationContext, ClassGenerationContext.GlobalObjectMap);
+
+    UE_LOG(LogSuzie, Display, TEXT("Generated %d objects from %.1f MB of streamed dumps: %d definitions parsed, at most %.1f MB of parsed definitions cached"),
+        ObjectPaths.Num(), StreamedDumpIndex->GetDumpDataSize() / (1024.0 * 1024.0), StreamedDumpIndex->GetNumParsedDefinitions(),
+        StreamedDumpIndex->GetPeakCachedDefinitionBytes() / (1024.0 * 1024.0));
+
+    // Generated types do not reference their definitions, so the index and the text files of the dumps can be released now
+    StreamedDumpIndex.Reset();
+}
+
+#undef LOCTEXT_NAMESPACE
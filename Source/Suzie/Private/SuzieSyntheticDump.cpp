@@ -0,0 +1,464 @@
+#include "SuzieSyntheticDump.h"
+#include "SuziePlugin.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+const TArray<TPair<FString, int32>>& FSuzieSyntheticDump::GetPropertyKinds()
+{
+    // Roughly the mix of a typical game dump, where most properties are plain values
+    static const TArray<TPair<FString, int32>> PropertyKinds = {
+        {TEXT("Int"), 4},
+        {TEXT("Float"), 4},
+        {TEXT("Bool"), 3},
+        {TEXT("Name"), 2},
+        {TEXT("Str"), 2},
+        {TEXT("Enum"), 2},
+        {TEXT("Struct"), 2},
+        {TEXT("Object"), 2},
+        {TEXT("Array"), 2},
+        {TEXT("Set"), 1},
+        {TEXT("Map"), 1},
+        {TEXT("Delegate"), 1},
+    };
+    return PropertyKinds;
+}
+
+bool FSuzieSyntheticDump::ParsePropertyKindWeights(const FString& WeightList, TMap<FString, int32>& OutWeights)
+{
+    TArray<FString> Entries;
+    WeightList.ParseIntoArray(Entries, TEXT(","), true);
+    for (const FString& Entry : Entries)
+    {
+        FString Kind;
+        FString Weight;
+        if (!Entry.Split(TEXT(":"), &Kind, &Weight) || !GetPropertyKinds().ContainsByPredicate([&](const TPair<FString, int32>& PropertyKind) { return PropertyKind.Key == Kind.TrimStartAndEnd(); }))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Unknown property kind weight %s"), *Entry);
+            return false;
+        }
+        OutWeights.Add(Kind.TrimStartAndEnd(), FMath::Max(0, FCString::Atoi(*Weight)));
+    }
+    return true;
+}
+
+// Builds the objects of a synthetic dump. Types are referenced by path before they are added, the same as in the real dumps
+class FSuzieSyntheticDumpBuilder
+{
+public:
+    explicit FSuzieSyntheticDumpBuilder(const FSuzieSyntheticDumpSettings& InSettings) :
+        Settings(InSettings),
+        Random(InSettings.Seed),
+        Objects(MakeShared<FJsonObject>())
+    {
+        for (const auto& [Kind, DefaultWeight] : FSuzieSyntheticDump::GetPropertyKinds())
+        {
+            const int32* Weight = Settings.PropertyKindWeights.Find(Kind);
+            PropertyKindWeights.Add({Kind, Weight ? *Weight : DefaultWeight});
+            TotalPropertyKindWeight += PropertyKindWeights.Last().Value;
+        }
+    }
+
+    TSharedRef<FJsonObject> Build()
+    {
+        for (int32 EnumIndex = 0; EnumIndex < Settings.NumEnums; EnumIndex++)
+        {
+            AddEnum(EnumIndex);
+        }
+        for (int32 StructIndex = 0; StructIndex < Settings.NumStructs; StructIndex++)
+        {
+            AddStruct(StructIndex);
+        }
+        for (int32 SignatureIndex = 0; SignatureIndex < Settings.NumDelegateSignatures; SignatureIndex++)
+        {
+            AddDelegateSignature(SignatureIndex);
+        }
+        for (int32 SubobjectLevel = 0; SubobjectLevel < Settings.SubobjectDepth; SubobjectLevel++)
+        {
+            AddSubobjectClasses(SubobjectLevel);
+        }
+        for (int32 ClassIndex = 0; ClassIndex < Settings.NumClasses; ClassIndex++)
+        {
+            AddClass(ClassIndex);
+        }
+
+        const TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+        RootObject->SetObjectField(TEXT("objects"), Objects);
+        return RootObject;
+    }
+private:
+    const FSuzieSyntheticDumpSettings& Settings;
+    FRandomStream Random;
+    TSharedRef<FJsonObject> Objects;
+    TArray<TPair<FString, int32>> PropertyKindWeights;
+    int32 TotalPropertyKindWeight{};
+
+    FString GetObjectPath(const FString& ObjectName) const
+    {
+        return Settings.PackageName + TEXT(".") + ObjectName;
+    }
+    FString GetEnumPath(const int32 EnumIndex) const { return GetObjectPath(FString::Printf(TEXT("ESyntheticEnum%d"), EnumIndex)); }
+    FString GetStructPath(const int32 StructIndex) const { return GetObjectPath(FString::Printf(TEXT("SyntheticStruct%d"), StructIndex)); }
+    FString GetDelegateSignaturePath(const int32 SignatureIndex) const { return GetObjectPath(FString::Printf(TEXT("SyntheticDelegate%d__DelegateSignature"), SignatureIndex)); }
+    FString GetClassPath(const int32 ClassIndex) const { return GetObjectPath(FString::Printf(TEXT("SyntheticClass%d"), ClassIndex)); }
+    FString GetSubobjectClassPath(const int32 SubobjectLevel, const bool bOverride) const
+    {
+        return GetObjectPath(FString::Printf(TEXT("SyntheticSubobject%d%s"), SubobjectLevel, bOverride ? TEXT("Override") : TEXT("")));
+    }
+    static FString GetDefaultObjectPath(const FString& ClassPath)
+    {
+        FString PackageName;
+        FString ClassName;
+        ClassPath.Split(TEXT("."), &PackageName, &ClassName, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+        return PackageName + TEXT(".Default__") + ClassName;
+    }
+
+    void AddObject(const FString& ObjectPath, const TSharedRef<FJsonObject>& Object)
+    {
+        Objects->SetObjectField(ObjectPath, Object);
+    }
+
+    static TSharedRef<FJsonObject> MakeProperty(const FString& Name, const TCHAR* Type, const TCHAR* Flags = TEXT("CPF_Edit | CPF_BlueprintVisible"))
+    {
+        const TSharedRef<FJsonObject> Property = MakeShared<FJsonObject>();
+        Property->SetStringField(TEXT("name"), Name);
+        Property->SetStringField(TEXT("type"), Type);
+        Property->SetStringField(TEXT("flags"), Flags);
+        Property->SetNumberField(TEXT("array_dim"), 1);
+        if (FCString::Strcmp(Type, TEXT("BoolProperty")) == 0)
+        {
+            // Native bool, the same as a bool that is not a bitfield in the real dumps
+            Property->SetNumberField(TEXT("field_size"), 1);
+            Property->SetNumberField(TEXT("byte_offset"), 0);
+            Property->SetNumberField(TEXT("field_mask"), 0xFF);
+        }
+        return Property;
+    }
+
+    static TSharedPtr<FJsonValue> MakeArray(TArray<TSharedPtr<FJsonValue>>&& Values)
+    {
+        return MakeShared<FJsonValueArray>(MoveTemp(Values));
+    }
+
+    const FString& PickPropertyKind()
+    {
+        int32 Roll = Random.RandHelper(FMath::Max(TotalPropertyKindWeight, 1));
+        for (const auto& [Kind, Weight] : PropertyKindWeights)
+        {
+            if (Roll < Weight)
+            {
+                return Kind;
+            }
+            Roll -= Weight;
+        }
+        return PropertyKindWeights[0].Key;
+    }
+
+    // Creates a property of the kind and its value in the default object. The value is not set for properties that have no value, such as delegates
+    TSharedRef<FJsonObject> MakePropertyOfKind(const FString& Name, FString Kind, TSharedPtr<FJsonValue>& OutValue)
+    {
+        // Kinds referencing types that are not generated fall back to plain integers
+        if ((Kind == TEXT("Enum") && Settings.NumEnums <= 0) || (Kind == TEXT("Struct") && Settings.NumStructs <= 0) || (Kind == TEXT("Delegate") && Settings.NumDelegateSignatures <= 0))
+        {
+            Kind = TEXT("Int");
+        }
+
+        if (Kind == TEXT("Float"))
+        {
+            OutValue = MakeShared<FJsonValueNumber>(Random.FRandRange(-1000.0f, 1000.0f));
+            return MakeProperty(Name, TEXT("FloatProperty"));
+        }
+        if (Kind == TEXT("Bool"))
+        {
+            OutValue = MakeShared<FJsonValueBoolean>(Random.RandHelper(2) == 1);
+            return MakeProperty(Name, TEXT("BoolProperty"));
+        }
+        if (Kind == TEXT("Name"))
+        {
+            OutValue = MakeShared<FJsonValueString>(FString::Printf(TEXT("SyntheticName_%d"), Random.RandHelper(1000)));
+            return MakeProperty(Name, TEXT("NameProperty"));
+        }
+        if (Kind == TEXT("Str"))
+        {
+            OutValue = MakeShared<FJsonValueString>(FString::Printf(TEXT("Synthetic string value %d"), Random.RandHelper(1000)));
+            return MakeProperty(Name, TEXT("StrProperty"));
+        }
+        if (Kind == TEXT("Enum"))
+        {
+            const int32 EnumIndex = Random.RandHelper(Settings.NumEnums);
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("EnumProperty"));
+            Property->SetStringField(TEXT("enum"), GetEnumPath(EnumIndex));
+            Property->SetObjectField(TEXT("container"), MakeProperty(TEXT("UnderlyingType"), TEXT("ByteProperty"), TEXT("")));
+            OutValue = MakeShared<FJsonValueString>(FString::Printf(TEXT("ESyntheticEnum%d::Value%d"), EnumIndex, Random.RandHelper(FMath::Max(Settings.EnumSize, 1))));
+            return Property;
+        }
+        if (Kind == TEXT("Struct"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("StructProperty"));
+            Property->SetStringField(TEXT("struct"), GetStructPath(Random.RandHelper(Settings.NumStructs)));
+            OutValue = MakeShared<FJsonValueObject>(MakeStructValue());
+            return Property;
+        }
+        if (Kind == TEXT("Object"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("ObjectProperty"));
+            Property->SetStringField(TEXT("property_class"), TEXT("/Script/CoreUObject.Object"));
+            if (Random.RandHelper(2) == 1)
+            {
+                OutValue = MakeShared<FJsonValueString>(TEXT("/Script/CoreUObject.Object"));
+            }
+            else
+            {
+                OutValue = MakeShared<FJsonValueNull>();
+            }
+            return Property;
+        }
+        if (Kind == TEXT("Array"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("ArrayProperty"));
+            Property->SetObjectField(TEXT("inner"), MakeProperty(Name, TEXT("IntProperty"), TEXT("")));
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            for (int32 ElementIndex = 0; ElementIndex < Settings.NumContainerElements; ElementIndex++)
+            {
+                Elements.Add(MakeShared<FJsonValueNumber>(Random.RandHelper(100000)));
+            }
+            OutValue = MakeArray(MoveTemp(Elements));
+            return Property;
+        }
+        if (Kind == TEXT("Set"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("SetProperty"));
+            Property->SetObjectField(TEXT("key_prop"), MakeProperty(Name, TEXT("NameProperty"), TEXT("")));
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            for (int32 ElementIndex = 0; ElementIndex < Settings.NumContainerElements; ElementIndex++)
+            {
+                Elements.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("SetElement_%d"), ElementIndex)));
+            }
+            OutValue = MakeArray(MoveTemp(Elements));
+            return Property;
+        }
+        if (Kind == TEXT("Map"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("MapProperty"));
+            Property->SetObjectField(TEXT("key_prop"), MakeProperty(Name + TEXT("_Key"), TEXT("IntProperty"), TEXT("")));
+            Property->SetObjectField(TEXT("value_prop"), MakeProperty(Name, TEXT("StrProperty"), TEXT("")));
+            TArray<TSharedPtr<FJsonValue>> Pairs;
+            for (int32 ElementIndex = 0; ElementIndex < Settings.NumContainerElements; ElementIndex++)
+            {
+                Pairs.Add(MakeArray({MakeShared<FJsonValueNumber>(ElementIndex), MakeShared<FJsonValueString>(FString::Printf(TEXT("Map value %d"), Random.RandHelper(1000)))}));
+            }
+            OutValue = MakeArray(MoveTemp(Pairs));
+            return Property;
+        }
+        if (Kind == TEXT("Delegate"))
+        {
+            const TSharedRef<FJsonObject> Property = MakeProperty(Name, TEXT("MulticastInlineDelegateProperty"), TEXT("CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable"));
+            Property->SetStringField(TEXT("signature_function"), GetDelegateSignaturePath(Random.RandHelper(Settings.NumDelegateSignatures)));
+            OutValue.Reset();
+            return Property;
+        }
+        OutValue = MakeShared<FJsonValueNumber>(Random.RandRange(-100000, 100000));
+        return MakeProperty(Name, TEXT("IntProperty"));
+    }
+
+    // All synthetic structs have the same layout, so that any value fits any of them
+    TSharedRef<FJsonObject> MakeStructValue()
+    {
+        const TSharedRef<FJsonObject> Value = MakeShared<FJsonObject>();
+        Value->SetNumberField(TEXT("X"), Random.RandRange(-1000, 1000));
+        Value->SetNumberField(TEXT("Y"), Random.FRandRange(-1000.0f, 1000.0f));
+        Value->SetStringField(TEXT("Tag"), FString::Printf(TEXT("SyntheticTag_%d"), Random.RandHelper(100)));
+        Value->SetBoolField(TEXT("bEnabled"), Random.RandHelper(2) == 1);
+        return Value;
+    }
+
+    void AddEnum(const int32 EnumIndex)
+    {
+        const FString EnumName = FString::Printf(TEXT("ESyntheticEnum%d"), EnumIndex);
+        TArray<TSharedPtr<FJsonValue>> Names;
+        for (int32 ValueIndex = 0; ValueIndex < Settings.EnumSize; ValueIndex++)
+        {
+            Names.Add(MakeArray({MakeShared<FJsonValueString>(FString::Printf(TEXT("%s::Value%d"), *EnumName, ValueIndex)), MakeShared<FJsonValueNumber>(ValueIndex)}));
+        }
+        Names.Add(MakeArray({MakeShared<FJsonValueString>(FString::Printf(TEXT("%s::%s_MAX"), *EnumName, *EnumName)), MakeShared<FJsonValueNumber>(Settings.EnumSize)}));
+
+        const TSharedRef<FJsonObject> Enum = MakeShared<FJsonObject>();
+        Enum->SetStringField(TEXT("type"), TEXT("Enum"));
+        Enum->SetStringField(TEXT("cpp_type"), EnumName);
+        Enum->SetArrayField(TEXT("names"), Names);
+        AddObject(GetEnumPath(EnumIndex), Enum);
+    }
+
+    void AddStruct(const int32 StructIndex)
+    {
+        const TSharedRef<FJsonObject> Struct = MakeShared<FJsonObject>();
+        Struct->SetStringField(TEXT("type"), TEXT("ScriptStruct"));
+        Struct->SetStringField(TEXT("struct_flags"), TEXT(""));
+        Struct->SetArrayField(TEXT("properties"), TArray<TSharedPtr<FJsonValue>>{
+            MakeShared<FJsonValueObject>(MakeProperty(TEXT("X"), TEXT("IntProperty"))),
+            MakeShared<FJsonValueObject>(MakeProperty(TEXT("Y"), TEXT("FloatProperty"))),
+            MakeShared<FJsonValueObject>(MakeProperty(TEXT("Tag"), TEXT("NameProperty"))),
+            MakeShared<FJsonValueObject>(MakeProperty(TEXT("bEnabled"), TEXT("BoolProperty"))),
+        });
+        AddObject(GetStructPath(StructIndex), Struct);
+    }
+
+    void AddDelegateSignature(const int32 SignatureIndex)
+    {
+        // Signatures cycle through a few parameter lists, so that many of them are identical like in game dumps
+        TArray<TSharedPtr<FJsonValue>> Parameters;
+        const int32 Shape = SignatureIndex % 4;
+        if (Shape == 1 || Shape == 2)
+        {
+            Parameters.Add(MakeShared<FJsonValueObject>(MakeProperty(TEXT("Value"), TEXT("IntProperty"), TEXT("CPF_Parm"))));
+        }
+        if (Shape == 2)
+        {
+            const TSharedRef<FJsonObject> Sender = MakeProperty(TEXT("Sender"), TEXT("ObjectProperty"), TEXT("CPF_Parm"));
+            Sender->SetStringField(TEXT("property_class"), TEXT("/Script/CoreUObject.Object"));
+            Parameters.Add(MakeShared<FJsonValueObject>(Sender));
+        }
+        if (Shape == 3)
+        {
+            Parameters.Add(MakeShared<FJsonValueObject>(MakeProperty(TEXT("Amount"), TEXT("FloatProperty"), TEXT("CPF_Parm"))));
+            Parameters.Add(MakeShared<FJsonValueObject>(MakeProperty(TEXT("Reason"), TEXT("NameProperty"), TEXT("CPF_Parm"))));
+        }
+
+        const TSharedRef<FJsonObject> Signature = MakeShared<FJsonObject>();
+        Signature->SetStringField(TEXT("type"), TEXT("Function"));
+        Signature->SetStringField(TEXT("function_flags"), TEXT("FUNC_Public | FUNC_Delegate | FUNC_MulticastDelegate"));
+        Signature->SetArrayField(TEXT("properties"), Parameters);
+        Signature->SetArrayField(TEXT("children"), TArray<TSharedPtr<FJsonValue>>());
+        AddObject(GetDelegateSignaturePath(SignatureIndex), Signature);
+    }
+
+    // Adds the default subobject of the level and its nested subobjects to the outer object. Returns the path of the subobject
+    FString AddSubobjectTree(const FString& OuterPath, const int32 SubobjectLevel, const bool bOverride)
+    {
+        const FString SubobjectPath = OuterPath + TEXT(":Sub");
+        TArray<TSharedPtr<FJsonValue>> Children;
+        if (SubobjectLevel + 1 < Settings.SubobjectDepth)
+        {
+            Children.Add(MakeShared<FJsonValueString>(AddSubobjectTree(SubobjectPath, SubobjectLevel + 1, bOverride)));
+        }
+
+        const TSharedRef<FJsonObject> PropertyValues = MakeShared<FJsonObject>();
+        PropertyValues->SetNumberField(FString::Printf(TEXT("Value%d"), SubobjectLevel), Random.RandHelper(1000));
+        if (bOverride)
+        {
+            PropertyValues->SetNumberField(FString::Printf(TEXT("OverrideValue%d"), SubobjectLevel), Random.RandHelper(1000));
+        }
+
+        const TSharedRef<FJsonObject> Subobject = MakeShared<FJsonObject>();
+        Subobject->SetStringField(TEXT("type"), TEXT("Object"));
+        Subobject->SetStringField(TEXT("class"), GetSubobjectClassPath(SubobjectLevel, bOverride));
+        Subobject->SetStringField(TEXT("object_flags"), TEXT("RF_Public | RF_DefaultSubObject | RF_ArchetypeObject"));
+        Subobject->SetObjectField(TEXT("property_values"), PropertyValues);
+        Subobject->SetArrayField(TEXT("children"), Children);
+        AddObject(SubobjectPath, Subobject);
+        return SubobjectPath;
+    }
+
+    void AddClassObject(const FString& ClassPath, const FString& SuperClassPath, TArray<TSharedPtr<FJsonValue>>&& Properties, TArray<TSharedPtr<FJsonValue>>&& Functions,
+        const TSharedRef<FJsonObject>& DefaultObjectPropertyValues, TArray<TSharedPtr<FJsonValue>>&& DefaultObjectChildren)
+    {
+        const FString DefaultObjectPath = GetDefaultObjectPath(ClassPath);
+        const TSharedRef<FJsonObject> Class = MakeShared<FJsonObject>();
+        Class->SetStringField(TEXT("type"), TEXT("Class"));
+        Class->SetStringField(TEXT("super_struct"), SuperClassPath);
+        Class->SetStringField(TEXT("class_flags"), TEXT(""));
+        Class->SetArrayField(TEXT("properties"), Properties);
+        Class->SetArrayField(TEXT("children"), Functions);
+        Class->SetStringField(TEXT("class_default_object"), DefaultObjectPath);
+        AddObject(ClassPath, Class);
+
+        const TSharedRef<FJsonObject> DefaultObject = MakeShared<FJsonObject>();
+        DefaultObject->SetStringField(TEXT("type"), TEXT("Object"));
+        DefaultObject->SetStringField(TEXT("class"), ClassPath);
+        DefaultObject->SetStringField(TEXT("object_flags"), TEXT("RF_Public | RF_ClassDefaultObject | RF_ArchetypeObject"));
+        DefaultObject->SetObjectField(TEXT("property_values"), DefaultObjectPropertyValues);
+        DefaultObject->SetArrayField(TEXT("children"), DefaultObjectChildren);
+        AddObject(DefaultObjectPath, DefaultObject);
+    }
+
+    // Each level has a subobject class and a class derived from it that overrides it
+    void AddSubobjectClasses(const int32 SubobjectLevel)
+    {
+        for (const bool bOverride : {false, true})
+        {
+            const FString ClassPath = GetSubobjectClassPath(SubobjectLevel, bOverride);
+            const FString PropertyName = FString::Printf(bOverride ? TEXT("OverrideValue%d") : TEXT("Value%d"), SubobjectLevel);
+            TArray<TSharedPtr<FJsonValue>> DefaultObjectChildren;
+            if (SubobjectLevel + 1 < Settings.SubobjectDepth)
+            {
+                DefaultObjectChildren.Add(MakeShared<FJsonValueString>(AddSubobjectTree(GetDefaultObjectPath(ClassPath), SubobjectLevel + 1, false)));
+            }
+            AddClassObject(ClassPath, bOverride ? GetSubobjectClassPath(SubobjectLevel, false) : TEXT("/Script/CoreUObject.Object"),
+                {MakeShared<FJsonValueObject>(MakeProperty(PropertyName, TEXT("IntProperty")))}, {}, MakeShared<FJsonObject>(), MoveTemp(DefaultObjectChildren));
+        }
+    }
+
+    void AddClass(const int32 ClassIndex)
+    {
+        const FString ClassPath = GetClassPath(ClassIndex);
+        const int32 HierarchyLevel = ClassIndex % FMath::Max(Settings.HierarchyDepth, 1);
+
+        // Property names are unique within the hierarchy so that properties of derived classes do not shadow the inherited ones
+        TArray<TSharedPtr<FJsonValue>> Properties;
+        const TSharedRef<FJsonObject> PropertyValues = MakeShared<FJsonObject>();
+        for (int32 PropertyIndex = 0; PropertyIndex < Settings.NumPropertiesPerClass; PropertyIndex++)
+        {
+            const FString PropertyName = FString::Printf(TEXT("Property%d_%d"), PropertyIndex, HierarchyLevel);
+            TSharedPtr<FJsonValue> PropertyValue;
+            Properties.Add(MakeShared<FJsonValueObject>(MakePropertyOfKind(PropertyName, PickPropertyKind(), PropertyValue)));
+            if (PropertyValue.IsValid())
+            {
+                PropertyValues->SetField(PropertyName, PropertyValue);
+            }
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Functions;
+        for (int32 FunctionIndex = 0; FunctionIndex < Settings.NumFunctionsPerClass; FunctionIndex++)
+        {
+            const FString FunctionPath = FString::Printf(TEXT("%s:SyntheticFunction%d"), *ClassPath, FunctionIndex);
+            const TSharedRef<FJsonObject> Function = MakeShared<FJsonObject>();
+            Function->SetStringField(TEXT("type"), TEXT("Function"));
+            Function->SetStringField(TEXT("function_flags"), TEXT("FUNC_Public | FUNC_BlueprintCallable | FUNC_BlueprintEvent | FUNC_Event"));
+            Function->SetArrayField(TEXT("properties"), TArray<TSharedPtr<FJsonValue>>{MakeShared<FJsonValueObject>(MakeProperty(TEXT("Value"), TEXT("IntProperty"), TEXT("CPF_Parm")))});
+            Function->SetArrayField(TEXT("children"), TArray<TSharedPtr<FJsonValue>>());
+            AddObject(FunctionPath, Function);
+            Functions.Add(MakeShared<FJsonValueString>(FunctionPath));
+        }
+
+        // Default objects list the inherited subobjects as well. Classes below the root of the hierarchy override their classes
+        TArray<TSharedPtr<FJsonValue>> DefaultObjectChildren;
+        if (Settings.SubobjectDepth > 0)
+        {
+            DefaultObjectChildren.Add(MakeShared<FJsonValueString>(AddSubobjectTree(GetDefaultObjectPath(ClassPath), 0, HierarchyLevel > 0)));
+        }
+
+        const FString SuperClassPath = HierarchyLevel == 0 ? Settings.NativeParentClassPath : GetClassPath(ClassIndex - 1);
+        AddClassObject(ClassPath, SuperClassPath, MoveTemp(Properties), MoveTemp(Functions), PropertyValues, MoveTemp(DefaultObjectChildren));
+    }
+};
+
+TSharedRef<FJsonObject> FSuzieSyntheticDump::Generate(const FSuzieSyntheticDumpSettings& Settings)
+{
+    return FSuzieSyntheticDumpBuilder(Settings).Build();
+}
+
+bool FSuzieSyntheticDump::Save(const FSuzieSyntheticDumpSettings& Settings, const FString& FilePath)
+{
+    FString DumpContent;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&DumpContent);
+    if (!FJsonSerializer::Serialize(Generate(Settings), Writer) || !FFileHelper::SaveStringToFile(DumpContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to write synthetic dump: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
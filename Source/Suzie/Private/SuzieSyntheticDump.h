@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+// Shape of a synthetic dump. Defaults produce a dump of a few megabytes that exercises every part of generation
+struct FSuzieSyntheticDumpSettings
+{
+    // Package all synthetic types are created in
+    FString PackageName{TEXT("/Script/SuzieSynthetic")};
+    // Native class the roots of the synthetic class hierarchies derive from
+    FString NativeParentClassPath{TEXT("/Script/CoreUObject.Object")};
+    int32 NumClasses{1000};
+    // Classes are generated in chains of this many classes, each deriving from the previous one
+    int32 HierarchyDepth{4};
+    int32 NumPropertiesPerClass{16};
+    int32 NumFunctionsPerClass{2};
+    // Relative frequency of each property kind, keyed by the names returned by FSuzieSyntheticDump::GetPropertyKinds. Kinds that are not listed use their default weight
+    TMap<FString, int32> PropertyKindWeights;
+    // Number of elements of each array, set and map in the class default objects
+    int32 NumContainerElements{8};
+    // Depth of the default subobject tree of each class. Classes below the root of a hierarchy override the classes of all of these subobjects
+    int32 SubobjectDepth{2};
+    int32 NumDelegateSignatures{32};
+    int32 NumStructs{32};
+    int32 NumEnums{32};
+    int32 EnumSize{16};
+    int32 Seed{0};
+};
+
+// Generates dumps in the format of the real ones from a description of their shape, so that generation can be benchmarked without a game dump
+class FSuzieSyntheticDump
+{
+public:
+    /** Returns the names of the property kinds that can be weighted, with their default weights */
+    static const TArray<TPair<FString, int32>>& GetPropertyKinds();
+
+    /** Parses a list of property kind weights in the Kind:Weight,Kind:Weight form. Returns false if a kind is unknown */
+    static bool ParsePropertyKindWeights(const FString& WeightList, TMap<FString, int32>& OutWeights);
+
+    /** Generates the root object of the dump, the same as the one read from a dump file */
+    static TSharedRef<FJsonObject> Generate(const FSuzieSyntheticDumpSettings& Settings);
+
+    /** Generates the dump and writes it to the file as UTF-8 */
+    static bool Save(const FSuzieSyntheticDumpSettings& Settings, const FString& FilePath);
+};
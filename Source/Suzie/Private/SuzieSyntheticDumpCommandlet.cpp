@@ -0,0 +1,130 @@
+#include "SuzieSyntheticDumpCommandlet.h"
+#include "SuziePlugin.h"
+#include "SuzieSyntheticDump.h"
+#include "SuzieGenerationProfile.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+USuzieSyntheticDumpCommandlet::USuzieSyntheticDumpCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Writes a synthetic dump and optionally benchmarks generating types from it");
+    HelpUsage = TEXT("-run=SuzieSyntheticDump [-OutputDir=<dir>] [-Classes=N] [-HierarchyDepth=N] [-Properties=N] [-Functions=N] [-PropertyMix=Int:4,Map:1,...] ")
+        TEXT("[-ContainerElements=N] [-SubobjectDepth=N] [-DelegateSignatures=N] [-Structs=N] [-Enums=N] [-EnumSize=N] [-NativeParent=<class path>] [-Seed=N] ")
+        TEXT("[-Benchmark [-Baseline=<profile>] [-SaveBaseline] [-Threshold=<percent>] [-ConstructionBenchmark=<objects per class>]]");
+    HelpParamNames = {TEXT("OutputDir"), TEXT("Classes"), TEXT("HierarchyDepth"), TEXT("Properties"), TEXT("Functions"), TEXT("PropertyMix"), TEXT("ContainerElements"),
+        TEXT("SubobjectDepth"), TEXT("DelegateSignatures"), TEXT("Structs"), TEXT("Enums"), TEXT("EnumSize"), TEXT("NativeParent"), TEXT("Seed"), TEXT("Benchmark"),
+        TEXT("Baseline"), TEXT("SaveBaseline"), TEXT("Threshold"), TEXT("ConstructionBenchmark")};
+    HelpParamDescriptions = {
+        TEXT("Directory the dump is written to, Saved/Suzie/Synthetic by default. The benchmark generation profile is written there as well"),
+        TEXT("Number of classes"),
+        TEXT("Length of the chains of classes deriving from each other"),
+        TEXT("Number of properties of each class"),
+        TEXT("Number of functions of each class"),
+        TEXT("Relative frequency of the property kinds: Int, Float, Bool, Name, Str, Enum, Struct, Object, Array, Set, Map and Delegate"),
+        TEXT("Number of elements of each array, set and map value"),
+        TEXT("Depth of the default subobject tree of each class"),
+        TEXT("Number of delegate signature functions"),
+        TEXT("Number of script structs"),
+        TEXT("Number of enums"),
+        TEXT("Number of values of each enum"),
+        TEXT("Native class the synthetic class hierarchies derive from"),
+        TEXT("Seed of the property kinds and values"),
+        TEXT("Generates types from the written dump the same way they are generated at startup, and reports the time of each phase"),
+        TEXT("Generation profile to compare the benchmark against"),
+        TEXT("Writes the benchmark profile to the baseline instead of comparing against it"),
+        TEXT("Percentage a phase can be slower than in the baseline before the commandlet fails, 10 by default"),
+        TEXT("Creates and garbage collects this many objects of each benchmarked generated class and its native parent, and reports the time per object"),
+    };
+}
+
+int32 USuzieSyntheticDumpCommandlet::Main(const FString& Params)
+{
+    FSuzieSyntheticDumpSettings Settings;
+    FParse::Value(*Params, TEXT("Classes="), Settings.NumClasses);
+    FParse::Value(*Params, TEXT("HierarchyDepth="), Settings.HierarchyDepth);
+    FParse::Value(*Params, TEXT("Properties="), Settings.NumPropertiesPerClass);
+    FParse::Value(*Params, TEXT("Functions="), Settings.NumFunctionsPerClass);
+    FParse::Value(*Params, TEXT("ContainerElements="), Settings.NumContainerElements);
+    FParse::Value(*Params, TEXT("SubobjectDepth="), Settings.SubobjectDepth);
+    FParse::Value(*Params, TEXT("DelegateSignatures="), Settings.NumDelegateSignatures);
+    FParse::Value(*Params, TEXT("Structs="), Settings.NumStructs);
+    FParse::Value(*Params, TEXT("Enums="), Settings.NumEnums);
+    FParse::Value(*Params, TEXT("EnumSize="), Settings.EnumSize);
+    FParse::Value(*Params, TEXT("NativeParent="), Settings.NativeParentClassPath);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+    FString PropertyMix;
+    if (FParse::Value(*Params, TEXT("PropertyMix="), PropertyMix, false) && !FSuzieSyntheticDump::ParsePropertyKindWeights(PropertyMix, Settings.PropertyKindWeights))
+    {
+        return 1;
+    }
+
+    FString OutputDirectory = FPaths::ProjectSavedDir() / TEXT("Suzie") / TEXT("Synthetic");
+    FParse::Value(*Params, TEXT("OutputDir="), OutputDirectory);
+    IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+    const FString DumpFilePath = OutputDirectory / TEXT("Synthetic.jmap");
+    const double GenerateStartTime = FPlatformTime::Seconds();
+    if (!FSuzieSyntheticDump::Save(Settings, DumpFilePath))
+    {
+        return 1;
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Wrote synthetic dump with %d classes to %s (%.1f MB) in %.2f seconds"), Settings.NumClasses, *DumpFilePath,
+        IFileManager::Get().FileSize(*DumpFilePath) / (1024.0 * 1024.0), FPlatformTime::Seconds() - GenerateStartTime);
+
+    if (!FParse::Param(*Params, TEXT("Benchmark")))
+    {
+        return 0;
+    }
+
+    const TSharedPtr<FJsonObject> Profile = FModuleManager::GetModuleChecked<FSuziePluginModule>(TEXT("Suzie")).BenchmarkJsonClassDefinitions(OutputDirectory);
+    if (!Profile.IsValid())
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Benchmark did not write a generation profile"));
+        return 1;
+    }
+    int32 NumConstructedObjectsPerClass = 0;
+    if (FParse::Value(*Params, TEXT("ConstructionBenchmark="), NumConstructedObjectsPerClass) && NumConstructedObjectsPerClass > 0)
+    {
+        FSuziePluginModule::BenchmarkObjectConstruction(NumConstructedObjectsPerClass, 16);
+    }
+
+    FString BaselineFilePath;
+    if (!FParse::Value(*Params, TEXT("Baseline="), BaselineFilePath))
+    {
+        FSuzieGenerationProfile::CompareWithBaseline(Profile, nullptr, 0.0f);
+        return 0;
+    }
+    if (FParse::Param(*Params, TEXT("SaveBaseline")))
+    {
+        FString ProfileContent;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ProfileContent);
+        if (!FJsonSerializer::Serialize(Profile.ToSharedRef(), Writer) || !FFileHelper::SaveStringToFile(ProfileContent, *BaselineFilePath))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to write baseline %s"), *BaselineFilePath);
+            return 1;
+        }
+        UE_LOG(LogSuzie, Display, TEXT("Wrote baseline %s"), *BaselineFilePath);
+        FSuzieGenerationProfile::CompareWithBaseline(Profile, nullptr, 0.0f);
+        return 0;
+    }
+
+    const TSharedPtr<FJsonObject> BaselineProfile = FSuzieGenerationProfile::Load(BaselineFilePath);
+    if (!BaselineProfile.IsValid())
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to read baseline %s, write it with -SaveBaseline"), *BaselineFilePath);
+        return 1;
+    }
+    float RegressionThresholdPercent = 10.0f;
+    FParse::Value(*Params, TEXT("Threshold="), RegressionThresholdPercent);
+    UE_LOG(LogSuzie, Display, TEXT("Comparing against baseline %s"), *BaselineFilePath);
+    return FSuzieGenerationProfile::CompareWithBaseline(Profile, BaselineProfile, RegressionThresholdPercent) ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuzieSyntheticDumpCommandlet.generated.h"
+
+// Writes a synthetic dump of the requested shape, and optionally benchmarks generating types from it against a stored baseline.
+// Run with -run=SuzieSyntheticDump, see HelpUsage for the parameters
+UCLASS()
+class USuzieSyntheticDumpCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+public:
+    USuzieSyntheticDumpCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,17 @@
+#include "SuzieTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(SuzieChannel);
+
+LLM_DEFINE_TAG(Suzie);
+
+TRACE_DECLARE_INT_COUNTER(SuzieClassesCreated, TEXT("Suzie/Classes Created"));
+TRACE_DECLARE_INT_COUNTER(SuzieStructsCreated, TEXT("Suzie/Structs Created"));
+TRACE_DECLARE_INT_COUNTER(SuzieEnumsCreated, TEXT("Suzie/Enums Created"));
+TRACE_DECLARE_INT_COUNTER(SuzieFunctionsCreated, TEXT("Suzie/Functions Created"));
+TRACE_DECLARE_INT_COUNTER(SuziePropertiesBuilt, TEXT("Suzie/Properties Built"));
+TRACE_DECLARE_INT_COUNTER(SuziePropertiesFromPrototypes, TEXT("Suzie/Properties From Prototypes"));
+TRACE_DECLARE_INT_COUNTER(SuzieFindObjectCalls, TEXT("Suzie/FindObject Calls"));
+TRACE_DECLARE_INT_COUNTER(SuzieDefinitionLookups, TEXT("Suzie/Definition Lookups"));
+TRACE_DECLARE_MEMORY_COUNTER(SuzieLoadPhaseMemory, TEXT("Suzie/Load Phase Memory"));
+TRACE_DECLARE_MEMORY_COUNTER(SuzieGenerationPhaseMemory, TEXT("Suzie/Generation Phase Memory"));
+TRACE_DECLARE_MEMORY_COUNTER(SuzieFinalizationPhaseMemory, TEXT("Suzie/Finalization Phase Memory"));
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ScopeExit.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// Trace channel for dump loading and type generation. Enable it with -trace=cpu,counters,Suzie to see the generation phases in Unreal Insights
+UE_TRACE_CHANNEL_EXTERN(SuzieChannel);
+
+// Low-Level Memory tracker tag for everything allocated while dumps are loaded and types are generated, visible with -llm in stat LLM and Unreal Insights
+LLM_DECLARE_TAG(Suzie);
+
+// Scope with a fixed name, e.g. SUZIE_TRACE_SCOPE(FinalizeClass)
+#define SUZIE_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Suzie_##Name, SuzieChannel)
+// Scope named after an object, so that the cost can be attributed to specific packages and classes
+#define SUZIE_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, SuzieChannel)
+
+#define SUZIE_TRACE_COUNTER_INCREMENT(CounterName) TRACE_COUNTER_INCREMENT(CounterName)
+
+// Sets the memory counter to the change of the used physical memory between the start and the end of the scope. Only meaningful for phases
+// that run on a single thread while nothing else allocates much, which is the case for startup generation
+#if COUNTERSTRACE_ENABLED
+#define SUZIE_TRACE_PHASE_MEMORY_SCOPE(CounterName) \
+    const int64 PREPROCESSOR_JOIN(SuzieUsedMemoryBefore, __LINE__) = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical); \
+    ON_SCOPE_EXIT { TRACE_COUNTER_SET(CounterName, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - PREPROCESSOR_JOIN(SuzieUsedMemoryBefore, __LINE__)); }
+#else
+#define SUZIE_TRACE_PHASE_MEMORY_SCOPE(CounterName)
+#endif
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieClassesCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieStructsCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieEnumsCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieFunctionsCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuziePropertiesBuilt);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuziePropertiesFromPrototypes);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieFindObjectCalls);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SuzieDefinitionLookups);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(SuzieLoadPhaseMemory);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(SuzieGenerationPhaseMemory);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(SuzieFinalizationPhaseMemory);
@@ -0,0 +1,50 @@
+#include "SuzieValidateDumpsCommandlet.h"
+#include "SuziePlugin.h"
+#include "SuzieGenerationProfile.h"
+#include "Dom/JsonObject.h"
+
+USuzieValidateDumpsCommandlet::USuzieValidateDumpsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Checks that types can be generated from the dumps, and optionally generates them and reports the time of each phase");
+    HelpUsage = TEXT("-run=SuzieValidateDumps [-DumpDir=<dir>] [-MaxIssues=N] [-WarningsAsErrors] [-Generate]");
+    HelpParamNames = {TEXT("DumpDir"), TEXT("MaxIssues"), TEXT("WarningsAsErrors"), TEXT("Generate")};
+    HelpParamDescriptions = {
+        TEXT("Directory the dumps are loaded from, Content/DynamicClasses of the project by default"),
+        TEXT("Number of problems that are logged, 100 by default"),
+        TEXT("Fails the commandlet on warnings as well as on errors"),
+        TEXT("Generates every type of the dumps once they are valid, the same way they are generated at startup, and logs the time of each phase"),
+    };
+}
+
+int32 USuzieValidateDumpsCommandlet::Main(const FString& Params)
+{
+    FString DumpDirectory;
+    FParse::Value(*Params, TEXT("DumpDir="), DumpDirectory);
+    int32 NumLoggedIssues = 100;
+    FParse::Value(*Params, TEXT("MaxIssues="), NumLoggedIssues);
+
+    FSuziePluginModule& SuzieModule = FModuleManager::GetModuleChecked<FSuziePluginModule>(TEXT("Suzie"));
+    if (!SuzieModule.ValidateJsonClassDefinitions(DumpDirectory, FMath::Max(0, NumLoggedIssues), FParse::Param(*Params, TEXT("WarningsAsErrors"))))
+    {
+        return 1;
+    }
+    if (!FParse::Param(*Params, TEXT("Generate")))
+    {
+        return 0;
+    }
+
+    // Generation would crash on the problems validation reports as errors, so it only runs on valid dumps
+    const double GenerationStartTime = FPlatformTime::Seconds();
+    const TSharedPtr<FJsonObject> Profile = SuzieModule.BenchmarkJsonClassDefinitions(DumpDirectory.IsEmpty() ? FSuziePluginModule::GetJsonClassDefinitionsDirectory() : DumpDirectory);
+    UE_LOG(LogSuzie, Display, TEXT("Generated types in %.2f seconds"), FPlatformTime::Seconds() - GenerationStartTime);
+    if (Profile.IsValid())
+    {
+        FSuzieGenerationProfile::CompareWithBaseline(Profile, nullptr, 0.0f);
+    }
+    return 0;
+}
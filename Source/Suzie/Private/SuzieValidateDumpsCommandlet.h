@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuzieValidateDumpsCommandlet.generated.h"
+
+// Checks that types can be generated from the dumps without starting the editor, and optionally generates them headless and reports how long it took.
+// Run with -run=SuzieValidateDumps, see HelpUsage for the parameters. Types are not generated at startup when this commandlet runs
+UCLASS()
+class USuzieValidateDumpsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+public:
+    USuzieValidateDumpsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
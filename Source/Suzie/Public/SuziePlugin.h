@@ -4,9 +4,44 @@
 #include "Modules/ModuleManager.h"
 #include "Styling/SlateStyle.h"
 #include "Framework/Commands/UICommandList.h"
+#include "Containers/Ticker.h"
+#include "Misc/SecureHash.h"
+
+struct FFileChangeData;
+struct FSuzieBlueprintExposureRule;
+class FSuzieGeneratedObjectReferencer;
+class FSuzieStreamedDumpIndex;
+class FSuzieGenerationProfile;
+struct FSuzieClassConstructionStats;
+struct FSuzieTypeMemory;
+class SDockTab;
+class FSpawnTabArgs;
+struct FScopedSlowTask;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSuzie, Log, All);
 
+struct FDynamicObjectConstructionData
+{
+    FName ObjectName;
+    UClass* ObjectClass{};
+    EObjectFlags ObjectFlags{};
+};
+
+// Object of the dumps with its parsed construction data. Parsed once per generation run, since finalization visits the same default subobjects
+// for the class, for its child classes and for the classes that override them. The definition itself is not kept, so that streamed dumps can still evict it
+struct FDynamicObjectTreeNode
+{
+    FString ObjectPath;
+    FDynamicObjectConstructionData ConstructionData;
+    // Only set once the children have been requested
+    TArray<FDynamicObjectTreeNode*> Children;
+    // Set when the class of the object has been found
+    bool bIsValid{};
+    bool bHasResolvedChildren{};
+
+    bool IsDefaultSubobject() const { return bIsValid && EnumHasAnyFlags(ConstructionData.ObjectFlags, RF_DefaultSubObject); }
+};
+
 struct FDynamicClassGenerationContext
 {
     // Key is the path of the object
@@ -19,13 +54,20 @@ struct FDynamicClassGenerationContext
     // Needed to handle edge case of re-entry when a parent class declares a function that takes a child class as an argument
     // We do not support this case fully, but we need to track it to avoid creating the same class multiple times
     TSet<FString> UnregisteredDynamicClassConstructionStack;
-};
-
-struct FDynamicObjectConstructionData
-{
-    FName ObjectName;
-    UClass* ObjectClass{};
-    EObjectFlags ObjectFlags{};
+    // Paths of the objects that have not been parsed because their package is native. Used to report references to them that cannot be resolved
+    const TSet<FString>* SkippedObjectPaths{};
+    // Number of properties that have been duplicated from a property prototype instead of being built from their descriptor
+    int32 NumPropertiesFromPrototypes{};
+    // When set, functions of dynamic classes are not created with their class, but recorded to be created later
+    bool bDeferClassFunctions{};
+    // Metadata for the created objects. Written to the packages at once when generation is done, instead of one value at a time
+    TMap<const UObject*, TMap<FName, FString>> PendingMetaData;
+    // Loads the definition of an object that is not in GlobalObjectMap, from the shard of a sharded dump or from the streamed dumps. Only set when these are used
+    TFunction<TSharedPtr<FJsonObject>(const FString& ObjectPath)> FindUnloadedObjectDefinition;
+    // Objects parsed during finalization, keyed by their path. Nodes are allocated separately so that the children can point to them
+    TMap<FString, TUniquePtr<FDynamicObjectTreeNode>> ObjectTree;
+    // Names of the default subobjects of the native parent classes of the finalized classes
+    TMap<const UClass*, TArray<FName>> NativeDefaultSubobjectNames;
 };
 
 struct FNestedDefaultSubobjectOverrideData
@@ -46,6 +88,39 @@ struct FDynamicClassConstructionData
     TArray<FNestedDefaultSubobjectOverrideData> DefaultSubobjectOverrides;
     // Archetype to use for constructing the object when no archetype has been provided or the provided archetype was a CDO
     UObject* DefaultObjectArchetype{};
+    // Runtime construction counters of the class, updated when Suzie.ConstructionStats is enabled
+    TSharedPtr<FSuzieClassConstructionStats> ConstructionStats;
+};
+
+// Hashes of the dump definitions that a dynamic type has been generated from. Used to find types that changed when a dump is reloaded
+struct FDynamicTypeDefinitionHashes
+{
+    // Covers everything that affects the layout of the type: its own definition, its functions and the shape of its default subobject tree
+    uint32 StructuralHash{};
+    // Covers property values of the class default object and its default subobjects
+    uint32 DefaultValuesHash{};
+};
+
+// Property built from the first descriptor of its shape. Later descriptors that only differ in the name are duplicated from it,
+// instead of parsing their flags and resolving their types again
+struct FSuziePropertyPrototype
+{
+    TSharedPtr<FJsonObject> Descriptor;
+    EPropertyFlags ExtraPropertyFlags{};
+    // Has no owner. Owned by the module until the prototypes are reset. The types it references are reported by the generated object referencer
+    FProperty* Property{};
+};
+
+// Property whose type could not be found during generation, and that uses a placeholder type instead
+struct FSuzieGenerationFallback
+{
+    // Path of the struct, function or container property the property belongs to
+    FString OwnerPath;
+    FString PropertyName;
+    // Path of the type from the dump, or the name of the property type if the property type itself is not supported
+    FString MissingTypePath;
+    // Name of the type used instead, or empty if the property has been left out
+    FString FallbackTypeName;
 };
 
 struct FDynamicClassConstructionIntermediates
@@ -62,10 +137,104 @@ public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
+    // Returns all objects generated from the dumps that are kept alive by the plugin
+    static TArray<TObjectPtr<UObject>> GetGeneratedObjects();
+    // Logs the time of a full garbage collection with the generated objects kept alive by the referencer and with each of them in the root set instead
+    static void CompareGarbageCollectionTiming(int32 NumCollections);
+
+    // Logs the memory used by each generated type and package, and writes the full report to CSV files in Saved/Suzie
+    static void ReportGeneratedTypeMemory(int32 NumLoggedRows);
+    // Measures the memory used by each generated type and package, sorted from the most expensive one
+    static void GatherGeneratedTypeMemory(TArray<FSuzieTypeMemory>& OutTypeMemory, TArray<FSuzieTypeMemory>& OutPackageMemory);
+
+    // Returns the directory the dumps are loaded from
+    static FString GetJsonClassDefinitionsDirectory();
+
+    // Generates types from the dumps in the directory instead of the project dumps, the same way they are generated at startup, and returns the generation profile.
+    // The profile is written to the directory and compared against the one of the previous run there. Used to benchmark generation on synthetic dumps
+    TSharedPtr<FJsonObject> BenchmarkJsonClassDefinitions(const FString& DumpDirectory);
+
+    // Creates and garbage collects objects of native parents, single level dynamic classes and deep dynamic hierarchies, and logs the time per object
+    // spent in the polymorphic constructor, property initialization and destruction of each case
+    static void BenchmarkObjectConstruction(int32 NumObjectsPerClass, int32 NumClassesPerCase);
+
+    // Loads the dumps in the directory, or the project dumps if it is empty, in parallel and checks that types can be generated from them without generating anything.
+    // Logs the problems found and returns false if there are errors, or warnings when they are treated as errors
+    bool ValidateJsonClassDefinitions(const FString& DumpDirectory, int32 NumLoggedIssues, bool bWarningsAsErrors);
+
+    // Returns the path the profile of the startup generation is written to
+    static FString GetGenerationProfileFilePath();
+    // Returns the properties that fell back to a placeholder type since the editor started
+    const TArray<FSuzieGenerationFallback>& GetGenerationFallbacks() const { return GenerationFallbacks; }
+    // Opens the diagnostics tab, which shows the last generation run
+    static void OpenDiagnosticsTab();
+
 private:
     TSharedPtr<FUICommandList> PluginCommands;
     TSharedPtr<FSlateStyleSet> PluginStyle;
 
+    // Handle of the directory watcher callback for the dynamic classes directory
+    FDelegateHandle DirectoryWatcherHandle;
+    // Ticker that applies the pending file changes once the files have stopped changing
+    FTSTicker::FDelegateHandle PendingHotReloadTickerHandle;
+    // Names of the dump files that have changed since the last hot reload
+    TSet<FString> FilesPendingHotReload;
+    // Time of the last change notification for the dynamic classes directory
+    double LastDirectoryChangeTime{};
+    // Definition hashes of the types generated from the merged dumps, keyed by type path
+    TMap<FString, FDynamicTypeDefinitionHashes> GeneratedTypeHashes;
+    // Names of the packages created for dynamic types. They are marked as compiled in, but their objects must not be skipped when parsing the dumps
+    TSet<FName> DynamicPackageNames;
+    // Names of the packages whose objects are skipped when parsing the dumps
+    TSet<FString> SkippedPackageNames;
+    // Paths of the objects that have been skipped when parsing the dumps
+    TSet<FString> SkippedObjectPaths;
+    // Hashes of the contents of the dump and overlay files, computed at most once per generation or hot reload
+    TMap<FString, FSHAHash> DumpFileContentHashes;
+    // Paths of the functions of dynamic classes that have not been created yet
+    TMap<UClass*, TArray<FString>> DeferredClassFunctions;
+    // Objects of the dumps that deferred functions are created from. Kept alive until all deferred functions have been created
+    TSharedPtr<FJsonObject> DeferredFunctionObjectMap;
+    // Handles of the callbacks that create the deferred functions in the background or when they are needed
+    FTSTicker::FDelegateHandle DeferredFunctionTickerHandle;
+    FDelegateHandle DeferredFunctionSyncLoadHandle;
+    FDelegateHandle DeferredFunctionAsyncLoadHandle;
+    FDelegateHandle DeferredFunctionPreBeginPIEHandle;
+    FDelegateHandle DeferredFunctionAssetEditorHandle;
+    // Shard files of the sharded dumps, keyed by the names of the packages they contain
+    TMap<FString, FString> DumpShardFilePathByPackageName;
+    // Names of the packages each package of the sharded dumps depends on
+    TMap<FString, TArray<FString>> DumpShardPackageDependencies;
+    // Name of the sharded dump each shard file belongs to
+    TMap<FString, FString> DumpShardDumpNames;
+    // Shard files that have been loaded, either at startup or on demand
+    TSet<FString> LoadedDumpShardFilePaths;
+    // Overlays of the sharded dumps, applied to the shards loaded on demand
+    TMap<FString, TArray<TSharedPtr<FJsonObject>>> ShardedDumpOverlays;
+    // Objects of the shards that have been loaded on demand during generation
+    TSharedPtr<FJsonObject> OnDemandShardObjects;
+    // Index of the streamed dumps. Only exists while classes are generated from them
+    TSharedPtr<FSuzieStreamedDumpIndex> StreamedDumpIndex;
+    // Profile of the startup generation. Only exists while the dumps are generated at startup
+    TUniquePtr<FSuzieGenerationProfile> GenerationProfile;
+    // Properties that fell back to a placeholder type, shown in the diagnostics tab
+    TArray<FSuzieGenerationFallback> GenerationFallbacks;
+    // Prototypes of the properties built so far, keyed by the hash of their descriptor without the name
+    TMap<uint32, TArray<FSuziePropertyPrototype>> PropertyPrototypes;
+
+    // Note that new objects can be created from other threads, but we only touch this map when creating dynamic classes,
+    // so we do not need an explicit mutex to guard the access to it during class initialization
+    static TMap<UClass*, FDynamicClassConstructionData> DynamicClassConstructionData;
+    // Keeps generated types and archetypes alive. Much cheaper for the garbage collector than adding tens of thousands of objects to the root set
+    static TUniquePtr<FSuzieGeneratedObjectReferencer> GeneratedObjectReferencer;
+    // Directory the dumps are loaded from while benchmarking. Files derived from the dumps are written there as well, so that the project ones are left alone
+    static FString BenchmarkDumpDirectory;
+
+    static void KeepGeneratedObjectAlive(UObject* Object);
+    static void ReleaseGeneratedObject(UObject* Object);
+    static void KeepFieldReferencesAlive(FField* Field);
+    static void ReleaseFieldReferences(FField* Field);
+
     UPackage* FindOrCreatePackage(FDynamicClassGenerationContext& Context, const FString& PackageName);
     static UClass* GetPlaceholderNonNativePropertyOwnerClass();
     UClass* FindOrCreateUnregisteredClass(FDynamicClassGenerationContext& Context, const FString& ClassPath);
@@ -79,16 +248,75 @@ private:
     static void PolymorphicClassConstructorInvocationHelper(const FObjectInitializer& ObjectInitializer);
     static void ExecutePolymorphicClassConstructorFrameForDynamicClass(const FObjectInitializer& ObjectInitializer, const UClass* DynamicClass);
 
-    static bool ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FString& ObjectPath, FDynamicObjectConstructionData& ObjectConstructionData);
+    static bool MatchesObjectPathPattern(const FString& ObjectPath, const FString& Pattern);
+    static FSuzieBlueprintExposureRule GetBlueprintExposure(const UObject* Type);
+    static void AddPendingMetaData(FDynamicClassGenerationContext& Context, const UObject* Object, const FName& Key, const FString& Value);
+    static void FlushPendingMetaData(FDynamicClassGenerationContext& Context);
+
+    static TSharedPtr<FJsonObject> FindObjectDefinition(const FDynamicClassGenerationContext& Context, const FString& ObjectPath);
+    static bool IsObjectSkippedDuringParse(const FDynamicClassGenerationContext& Context, const FString& ObjectPath);
+    static bool ParseObjectConstructionData(const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition, FDynamicObjectConstructionData& ObjectConstructionData);
+    static FDynamicObjectTreeNode& FindOrAddObjectTreeNode(FDynamicClassGenerationContext& Context, const FString& ObjectPath);
+    static const TArray<FDynamicObjectTreeNode*>& GetObjectTreeNodeChildren(FDynamicClassGenerationContext& Context, FDynamicObjectTreeNode& Node);
+    static const TArray<FName>& GetNativeDefaultSubobjectNames(FDynamicClassGenerationContext& Context, const UClass* NativeClass);
     void DeserializeStructProperties(const UStruct* Struct, void* StructData, const TSharedPtr<FJsonObject>& PropertyValues);
     static void DeserializeEnumValue(const FNumericProperty* UnderlyingProperty, void* PropertyValuePtr, const UEnum* Enum, const TSharedPtr<FJsonValue>& JsonPropertyValue);
     void DeserializePropertyValue(const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue);
-    void CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName> SubobjectNameStack, const FString& SubobjectPath, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData);
-    void DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const TSharedPtr<FJsonObject>& ObjectDefinition);
+    void CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName>& SubobjectNameStack, FDynamicObjectTreeNode& SubobjectNode, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData);
+    void DeserializeObjectAndSubobjectPropertyValuesRecursive(FDynamicClassGenerationContext& Context, UObject* Object, FDynamicObjectTreeNode& ObjectNode);
+    static void CreateDefaultObjectArchetype(UClass* Class, FDynamicClassConstructionData& ClassConstructionData);
     void FinalizeClass(FDynamicClassGenerationContext& Context, UClass* Class);
 
     void CreateDynamicClassesForJsonObject(const TSharedPtr<FJsonObject>& RootObject);
+    void CreateDynamicTypeForObject(FDynamicClassGenerationContext& Context, const FString& ObjectPath, const TSharedPtr<FJsonObject>& ObjectDefinition);
+    void FinishCreatingDynamicClasses(FDynamicClassGenerationContext& Context, const TSharedPtr<FJsonObject>& Objects);
+    void CreateDynamicClassesFromStreamedDumps(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, FScopedSlowTask& SlowTask);
     void ProcessAllJsonClassDefinitions();
+    void GenerateAllJsonClassDefinitions(const TArray<FString>& JsonFileNames, const TArray<FString>& OverlayJsonFileNames, FScopedSlowTask& SlowTask);
+
+    static bool LoadJsonClassDefinitionFileContents(const FString& FilePath, TArray<uint8>& OutFileContents);
+    static bool IsObjectInPackages(const FString& ObjectPath, const TSet<FString>* PackageNames);
+    static bool LoadJsonClassDefinitionFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutRootObject, const TSet<FString>* InSkippedPackageNames = nullptr, TSet<FString>* OutSkippedObjectPaths = nullptr);
+    void GatherSkippedPackageNames();
+    static void FindJsonClassDefinitionFiles(TArray<FString>& OutDumpFileNames, TArray<FString>& OutOverlayFileNames);
+    static bool IsOverlayJsonClassDefinitionFile(const FString& JsonFileName);
+    static FString GetJsonClassDefinitionDumpName(const FString& JsonFileName);
+    void LoadJsonClassDefinitionOverlays(const TArray<FString>& OverlayFileNames, TMap<FString, TArray<TSharedPtr<FJsonObject>>>& OutOverlaysByDumpName);
+    static void ApplyJsonClassDefinitionOverlay(const TSharedPtr<FJsonObject>& RootObject, const TSharedPtr<FJsonObject>& OverlayRootObject, bool bAddNewObjects = true);
+    static void MergeJsonClassDefinitionObjects(TMap<FString, TSharedPtr<FJsonValue>>& MergedObjectMap, TMap<FString, TSharedPtr<FJsonValue>>&& ObjectMap, const FString& JsonFileName);
+    bool LoadMergedJsonClassDefinitions(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, const TSet<FString>* ReachabilitySeedObjectPaths, TSharedPtr<FJsonObject>& OutRootObject, FScopedSlowTask& SlowTask);
+    static void GatherReachableTypeSeeds(TSet<FString>& OutSeedObjectPaths);
+    static FString GetDumpSnapshotFilePath();
+    static FString GetBaseDumpSnapshotFilePath(const FString& JsonFileName);
+    FSHAHash GetDumpFileContentHash(const FString& FilePath);
+    FSHAHash ComputeBaseDumpSnapshotInputHash(const FString& FilePath);
+    bool LoadBaseJsonClassDefinitionFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutRootObject);
+    FSHAHash ComputeDumpSnapshotInputHash(const TArray<FString>& DumpFileNames, const TArray<FString>& OverlayFileNames, const TSet<FString>* ReachabilitySeedObjectPaths);
+    static bool IsJsonClassDefinitionShardIndexFile(const FString& JsonFileName);
+    bool LoadJsonClassDefinitionShardIndex(const FString& IndexFilePath, const FString& DumpName, TArray<FString>& OutShardFilePaths);
+    bool LoadShardedJsonClassDefinitions(const FString& IndexFilePath, const TSet<FString>* ReachabilitySeedObjectPaths, const TSet<FString>& PreviouslyLoadedShardFilePaths, TSharedPtr<FJsonObject>& OutRootObject);
+    TSharedPtr<FJsonObject> LoadObjectDefinitionFromShard(const FString& ObjectPath);
+    void SetupOnDemandObjectDefinitions(FDynamicClassGenerationContext& Context);
+    static bool IsAlwaysGeneratedType(const FString& ObjectPath);
+    static void GatherReachableObjectPaths(const TSet<FString>& SeedObjectPaths, TFunctionRef<TSharedPtr<FJsonObject>(const FString&)> FindDefinition, TSet<FString>& OutReachableObjectPaths);
+    static void PruneUnreachableObjects(const TSharedPtr<FJsonObject>& RootObject, const TSet<FString>& SeedObjectPaths);
+    static uint32 HashJsonValue(const TSharedPtr<FJsonValue>& JsonValue);
+    static void ComputeTypeDefinitionHashes(const TSharedPtr<FJsonObject>& Objects, TMap<FString, FDynamicTypeDefinitionHashes>& OutTypeHashes);
+
+    void BeginMaterializingDeferredFunctions(const TSharedPtr<FJsonObject>& Objects);
+    void MaterializeDeferredFunctions(double TimeBudgetSeconds);
+    void FlushDeferredFunctions();
+    bool MaterializeDeferredFunctionsOnIdle(float DeltaTime);
+    void StopMaterializingDeferredFunctions();
+
+    void StartWatchingJsonClassDefinitions();
+    void StopWatchingJsonClassDefinitions();
+    void OnJsonClassDefinitionsDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+    bool ProcessPendingHotReload(float DeltaTime);
+    void HotReloadJsonClassDefinitions();
+    void ReapplyClassDefaultValues(FDynamicClassGenerationContext& Context, UClass* Class, const FString& ClassDefaultObjectPath);
+    static void RetireDynamicClass(UClass* Class);
+    static void ReplaceRetiredClassReferences(const TMap<UClass*, UClass*>& OldToNewClassMap);
 
     static void ParseObjectPath(const FString& ObjectPath, FString& OutOuterObjectPath, FString& OutObjectName);
     static TSet<FString> ParseFlags(const FString& Flags);
@@ -97,4 +325,12 @@ private:
     void AddFunctionToClass(FDynamicClassGenerationContext& Context, UClass* Class, const FString& FunctionPath, EFunctionFlags ExtraFunctionFlags = FUNC_None);
 
     FProperty* BuildProperty(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags = CPF_None);
+    FProperty* BuildPropertyFromDescriptor(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags);
+    // Deletes the property prototypes. Needed when the types they reference are replaced
+    void ResetPropertyPrototypes();
+    void AddGenerationFallback(FFieldVariant Owner, const FString& PropertyName, const FString& MissingTypePath, const UObject* FallbackType);
+
+    void RegisterDiagnosticsTab();
+    void UnregisterDiagnosticsTab();
+    TSharedRef<SDockTab> SpawnDiagnosticsTab(const FSpawnTabArgs& SpawnTabArgs);
 };
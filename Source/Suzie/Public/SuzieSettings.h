@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuzieSettings.generated.h"
+
+// Controls which parts of the generated types matching the pattern are visible to Blueprints
+USTRUCT()
+struct SUZIE_API FSuzieBlueprintExposureRule
+{
+    GENERATED_BODY()
+
+    // Object path, package name or wildcard of the types the rule applies to
+    UPROPERTY(EditAnywhere, Category = "Exposure")
+    FString Pattern;
+
+    // Whether the types can be used as Blueprint variable types and Blueprint parent classes
+    UPROPERTY(EditAnywhere, Category = "Exposure")
+    bool bExposeTypes{true};
+
+    // Whether the properties of the types are visible and editable in Blueprints
+    UPROPERTY(EditAnywhere, Category = "Exposure")
+    bool bExposeProperties{true};
+
+    // Whether the functions of the classes can be called from Blueprints
+    UPROPERTY(EditAnywhere, Category = "Exposure")
+    bool bExposeFunctions{true};
+};
+
+// Project settings controlling how Suzie reads dumps and generates dynamic classes from them
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Suzie"))
+class SUZIE_API USuzieSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+public:
+    USuzieSettings();
+
+    virtual FName GetCategoryName() const override;
+
+    // When enabled, the DynamicClasses directory is watched for changes and modified dumps are applied to the running editor
+    UPROPERTY(config, EditAnywhere, Category = "Hot Reload")
+    bool bHotReloadChangedDumps;
+
+    // Time in seconds to wait after the last file change before applying it. Dumps are large and are usually written in multiple chunks
+    UPROPERTY(config, EditAnywhere, Category = "Hot Reload", meta = (EditCondition = "bHotReloadChangedDumps", ClampMin = "0.0"))
+    float HotReloadDelay;
+
+    // When enabled, objects in packages of engine and engine plugin modules (e.g. /Script/Engine) are skipped when parsing the dumps instead of being
+    // parsed and then discarded because they already exist. Packages of project modules are always parsed, even if the project has a module named
+    // after the game module. Disable if the game adds types to engine packages that do not exist in the editor
+    UPROPERTY(config, EditAnywhere, Category = "Generation")
+    bool bSkipObjectsInNativePackages;
+
+    // Names of additional packages whose objects are skipped when parsing the dumps, e.g. /Script/SomeUnneededPlugin
+    UPROPERTY(config, EditAnywhere, Category = "Generation")
+    TArray<FString> SkippedPackages;
+
+    // When enabled, functions of dynamic classes are created in the background after the editor has started instead of with their classes.
+    // All remaining functions are created immediately when a package is loaded synchronously or asynchronously, an asset editor is opened or Play In Editor is started
+    UPROPERTY(config, EditAnywhere, Category = "Generation")
+    bool bDeferClassFunctions;
+
+    // When enabled, the merged dumps are written to a binary snapshot in Saved/Suzie after they have been loaded, and the next startup reads the snapshot
+    // instead of decompressing and parsing the dumps, as long as the dumps, overlays, skipped packages and reachable types have not changed
+    UPROPERTY(config, EditAnywhere, Category = "Generation")
+    bool bUseDumpSnapshot;
+
+    // Rules controlling which generated types and members are visible to Blueprints. Types not matching any rule are fully exposed.
+    // When multiple rules match a type, the last one is used, so general rules should come first. Hiding unneeded packages makes Blueprint menus faster
+    UPROPERTY(config, EditAnywhere, Category = "Blueprint Exposure")
+    TArray<FSuzieBlueprintExposureRule> BlueprintExposureRules;
+
+    // When enabled, only types needed by the project are generated: parent classes of project Blueprints, classes of project assets,
+    // types listed in AlwaysGeneratedTypes, and everything these types reference
+    UPROPERTY(config, EditAnywhere, Category = "Generation")
+    bool bOnlyGenerateReachableTypes;
+
+    // Types that are always generated when only reachable types are generated. Entries can be object paths, package names or wildcards
+    UPROPERTY(config, EditAnywhere, Category = "Generation", meta = (EditCondition = "bOnlyGenerateReachableTypes"))
+    TArray<FString> AlwaysGeneratedTypes;
+
+    // When enabled, dumps are only indexed at startup and each object is parsed when its type is generated, so huge dumps can be used without
+    // holding all of their definitions in memory. Hot reload and deferred class functions are not available in this mode
+    UPROPERTY(config, EditAnywhere, Category = "Streaming")
+    bool bStreamDumps;
+
+    // Memory in megabytes parsed object definitions can use while streaming. Least recently used definitions are released and read from disk again when needed.
+    // The text of the dumps stays on disk: uncompressed dumps are read in place, and compressed dumps are decompressed into temporary files
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (EditCondition = "bStreamDumps", ClampMin = "16"))
+    int32 StreamingMemoryCeilingMB;
+
+    // When enabled, the wall time and memory of each generation phase, the time spent on each dump and the most expensive types are written to
+    // Saved/Suzie/GenerationProfile.json after the dumps have been generated at startup
+    UPROPERTY(config, EditAnywhere, Category = "Profiling")
+    bool bWriteGenerationProfile;
+
+    // Number of the most expensive classes and structs listed in the generation profile
+    UPROPERTY(config, EditAnywhere, Category = "Profiling", meta = (EditCondition = "bWriteGenerationProfile", ClampMin = "0"))
+    int32 NumProfiledMostExpensiveTypes;
+
+    // Maximum time in seconds of generation phases, keyed by the phase name in the profile (e.g. LoadDumps, CreateTypes, FinishCreatingTypes).
+    // Phases over their budget are logged as warnings, and as errors in commandlets so that automated runs fail
+    UPROPERTY(config, EditAnywhere, Category = "Profiling", meta = (EditCondition = "bWriteGenerationProfile"))
+    TMap<FString, float> GenerationPhaseBudgets;
+
+    // Phases that are slower than in the previous profile by more than this percentage are reported the same as phases over their budget. 0 disables the comparison
+    UPROPERTY(config, EditAnywhere, Category = "Profiling", meta = (EditCondition = "bWriteGenerationProfile", ClampMin = "0.0"))
+    float GenerationRegressionThresholdPercent;
+};
@@ -1,3 +1,4 @@
+using System.IO;
 using UnrealBuildTool;
 public class Suzie : ModuleRules
 {
@@ -29,9 +30,23 @@ public class Suzie : ModuleRules
 				"Projects",
 				"BlueprintGraph",
 				"zlib",
+				"DeveloperSettings",
+				"DirectoryWatcher",
+				"AssetRegistry",
+				"Slate",
+				"SlateCore",
+				"WorkspaceMenuStructure",
 			}
 			);
 
+		// Zstandard is not part of every engine version, so .jmap.zst dumps are only supported when the engine ships it
+		bool bWithZstd = Directory.Exists(Path.Combine(EngineDirectory, "Source", "ThirdParty", "zstd"));
+		if (bWithZstd)
+		{
+			PrivateDependencyModuleNames.Add("zstd");
+		}
+		PrivateDefinitions.Add("WITH_SUZIE_ZSTD=" + (bWithZstd ? "1" : "0"));
+
 		DynamicallyLoadedModuleNames.AddRange(new string[] {});
 	}
 }